@@ -3,9 +3,16 @@
 out vec4 FragColor;
 
 uniform sampler2D atlas;
+// Rectangle of each atlas texture: bottom-left corner in xy, size in zw. See MAX_ATLAS_TEXTURES.
+uniform vec4 textureRects[64];
 
 in vec2 TexCoords;
+flat in uint TextureIndex;
+in float Brightness;
 
 void main() {
-   FragColor = vec4(vec3(texture(atlas, TexCoords)), 1.0);
+   // Texture coordinates are in tiles: wrap them so merged faces repeat the texture once per block.
+   vec4 rect = textureRects[TextureIndex];
+   vec2 atlasCoords = rect.xy + fract(TexCoords) * rect.zw;
+   FragColor = vec4(vec3(texture(atlas, atlasCoords)) * Brightness, 1.0);
 }
@@ -1,15 +1,27 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoords;
+// Packed vertex, see chunkMesher.hpp for the layout
+layout (location = 0) in uvec2 aData;
 
 uniform mat4 projection;
 uniform mat4 view;
 uniform mat4 model;
 
 out vec2 TexCoords;
+flat out uint TextureIndex;
+out float Brightness;
 
 void main() {
-   gl_Position = projection * view * model * vec4(aPos, 1.0);
+   vec3 position = vec3(aData.x & 63u, (aData.x >> 6) & 127u, (aData.x >> 13) & 63u);
+   gl_Position = projection * view * model * vec4(position, 1.0);
 
-   TexCoords = aTexCoords;
-}
\ No newline at end of file
+   TexCoords = vec2(aData.y & 127u, (aData.y >> 7) & 127u);
+   TextureIndex = aData.y >> 16;
+
+   // Each light level is 80% as bright as the next one, the darkest blocks staying faintly visible
+   uint skyLight = (aData.x >> 23) & 15u;
+   uint blockLight = (aData.x >> 19) & 15u;
+   float level = float(max(skyLight, blockLight));
+   // Ambient occlusion darkens vertices surrounded by blocks down to half their brightness
+   float occlusion = float((aData.x >> 27) & 3u);
+   Brightness = max(pow(0.8, 15.0 - level), 0.05) * (0.5 + occlusion / 6.0);
+}
@@ -0,0 +1,11 @@
+#ifndef VOXELS_ALLOCATIONCOUNTER_HPP
+#define VOXELS_ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+// Counts heap allocations made through the global operator new, from every thread.
+namespace AllocationCounter {
+    [[nodiscard]] uint64_t count();
+}
+
+#endif //VOXELS_ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,33 @@
+#include "benchmark.hpp"
+
+#include <format>
+#include <iostream>
+
+std::string benchmarkFilter;
+
+void Benchmark::setFilter(const std::string &filter) {
+    benchmarkFilter = filter;
+}
+
+bool Benchmark::isSelected(const std::string &name) {
+    return name.find(benchmarkFilter) != std::string::npos;
+}
+
+void Benchmark::printHeader() {
+    std::cout << std::format("{:<36} {:>14} {:>12} {:>24}", "benchmark", "ns/op", "allocs/op", "throughput") << std::endl;
+}
+
+void Benchmark::printResult(const BenchmarkResult &result) {
+    // Throughput with an SI prefix, e.g. 12.34 M blocks/s
+    double throughput = result.itemsPerSecond;
+    const char* prefix = "";
+    for (const char* next : { "k", "M", "G" }) {
+        if (throughput < 1000.0)
+            break;
+        throughput /= 1000.0;
+        prefix = next;
+    }
+
+    std::cout << std::format("{:<36} {:>14.1f} {:>12.2f} {:>10.2f} {}{}/s",
+        result.name, result.nanosecondsPerOp, result.allocationsPerOp, throughput, prefix, result.itemUnit) << std::endl;
+}
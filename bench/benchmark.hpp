@@ -0,0 +1,89 @@
+#ifndef VOXELS_BENCHMARK_HPP
+#define VOXELS_BENCHMARK_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "allocationCounter.hpp"
+
+// Number of timed batches of a benchmark, the median batch is reported
+#define BENCHMARK_BATCHES 5
+// Batches are made of enough iterations to last at least this long
+#define BENCHMARK_MIN_BATCH_NANOSECONDS 20000000.0
+
+struct BenchmarkResult {
+    std::string name;
+    double nanosecondsPerOp;
+    double allocationsPerOp;
+    double itemsPerSecond;
+    std::string itemUnit;
+};
+
+namespace Benchmark {
+    // Only benchmarks whose name contains the filter are run.
+    void setFilter(const std::string &filter);
+    [[nodiscard]] bool isSelected(const std::string &name);
+
+    void printHeader();
+    void printResult(const BenchmarkResult &result);
+
+    // Keeps the compiler from optimizing away the computation of value.
+    template<typename T>
+    void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * Times op and prints its result. The number of iterations per batch is doubled until a batch
+     * lasts BENCHMARK_MIN_BATCH_NANOSECONDS, then the median of BENCHMARK_BATCHES batches is kept.
+     * Each call of op processes itemsPerOp items, counted in the throughput.
+     */
+    template<typename Op>
+    void run(const std::string &name, Op &&op, const double itemsPerOp = 1, const std::string &itemUnit = "ops") {
+        if (!isSelected(name))
+            return;
+
+        using Clock = std::chrono::steady_clock;
+        const auto timeBatch = [&op](const uint64_t iterations) {
+            const Clock::time_point start = Clock::now();
+            for (uint64_t i = 0; i < iterations; i++) {
+                op();
+            }
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+
+        uint64_t iterations = 1;
+        while (timeBatch(iterations) < BENCHMARK_MIN_BATCH_NANOSECONDS) {
+            iterations *= 2;
+        }
+
+        std::array<double, BENCHMARK_BATCHES> nanosecondsPerOp {};
+        const uint64_t allocationsBefore = AllocationCounter::count();
+        for (double &batch : nanosecondsPerOp) {
+            batch = timeBatch(iterations) / static_cast<double>(iterations);
+        }
+        const uint64_t allocations = AllocationCounter::count() - allocationsBefore;
+
+        std::sort(nanosecondsPerOp.begin(), nanosecondsPerOp.end());
+        const double median = nanosecondsPerOp[BENCHMARK_BATCHES / 2];
+        printResult({
+            name,
+            median,
+            static_cast<double>(allocations) / static_cast<double>(iterations * BENCHMARK_BATCHES),
+            itemsPerOp * 1e9 / median,
+            itemUnit
+        });
+    }
+}
+
+#endif //VOXELS_BENCHMARK_HPP
@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "benchmark.hpp"
+#include "texturemanip/atlasLayout.hpp"
+#include "world/chunk.hpp"
+#include "world/chunkMap.hpp"
+#include "world/chunkMesher.hpp"
+#include "world/generationPipeline.hpp"
+#include "world/lightEngine.hpp"
+#include "world/sectionSnapshot.hpp"
+#include "world/noise.hpp"
+#include "world/regionStorage.hpp"
+#include "world/terrainGenerator.hpp"
+#include "world/world.hpp"
+#include "world/worldEdit.hpp"
+
+// Seed of every random input, so runs are comparable
+#define BENCHMARK_SEED 42
+// Number of precomputed random inputs cycled through by the query benchmarks
+#define BENCHMARK_INPUTS 4096
+// Number of chunks cycled through by the save and load benchmarks
+#define BENCHMARK_SAVED_CHUNKS 64
+// Chunks along z and y of the rows streamed through the generation pipeline
+#define BENCHMARK_PIPELINE_ROW_WIDTH 8
+#define BENCHMARK_PIPELINE_ROW_HEIGHT 2
+
+// Same texture names as the game, at arbitrary positions
+AtlasLayout createAtlasLayout() {
+    AtlasLayout atlasLayout(64, 32);
+    atlasLayout.registerTextureUV("test", {0, 0, 16, 16});
+    atlasLayout.registerTextureUV("stone", {0, 16, 16, 16});
+    atlasLayout.registerTextureUV("grass_top", {16, 16, 16, 16});
+    atlasLayout.registerTextureUV("grass_sides", {16, 0, 16, 16});
+    atlasLayout.registerTextureUV("log_top", {32, 0, 16, 16});
+    atlasLayout.registerTextureUV("log_sides", {48, 0, 16, 16});
+    atlasLayout.registerTextureUV("leaves", {32, 16, 16, 16});
+    atlasLayout.validateBlockFaceTextures();
+    return atlasLayout;
+}
+
+// A stone floor with a grass top
+Chunk createFlatChunk() {
+    Chunk chunk({0, 0, 0});
+    FlatTerrainGenerator().generate(chunk, {0, 0, 0});
+    return chunk;
+}
+
+// Random blocks, half of them air
+Chunk createNoiseChunk() {
+    Chunk chunk({0, 0, 0});
+    std::mt19937 random(BENCHMARK_SEED);
+    for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+        for (int32_t y = 0; y < CHUNK_HEIGHT; y++) {
+            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+                chunk.setBlock({x, y, z}, random() % 2 == 0 ? Blocks::AIR.id : static_cast<block_id>(1 + random() % 3));
+            }
+        }
+    }
+    return chunk;
+}
+
+// Every other block is solid, so every face of every block is visible
+Chunk createCheckerboardChunk() {
+    Chunk chunk({0, 0, 0});
+    for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+        for (int32_t y = 0; y < CHUNK_HEIGHT; y++) {
+            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+                chunk.setBlock({x, y, z}, (x + y + z) % 2 == 0 ? Blocks::STONE : Blocks::AIR);
+            }
+        }
+    }
+    return chunk;
+}
+
+void benchmarkMeshing(const AtlasLayout &atlasLayout) {
+    std::pair<const char*, Chunk> chunks[] = {
+        { "flat", createFlatChunk() },
+        { "noise", createNoiseChunk() },
+        { "checkerboard", createCheckerboardChunk() },
+    };
+    const std::pair<const char*, MeshingMode> meshingModes[] = {
+        { "naive", MeshingMode::NAIVE },
+        { "greedy", MeshingMode::GREEDY },
+        { "binary", MeshingMode::BINARY },
+    };
+
+    for (auto &[worldName, chunk] : chunks) {
+        // The bottom section holds the surface of the flat chunk
+        Benchmark::run(std::format("snapshot/{}", worldName), [&chunk] {
+            Benchmark::doNotOptimize(chunk.createMeshSnapshot(0, {}, 1));
+        }, SECTION_VOLUME, "blocks");
+
+        const std::unique_ptr<SectionSnapshot> snapshot = chunk.createMeshSnapshot(0, {}, 1);
+        for (const auto &[modeName, meshingMode] : meshingModes) {
+            Benchmark::run(std::format("mesh/{}/{}", worldName, modeName), [&] {
+                Benchmark::doNotOptimize(ChunkMesher::buildMesh(*snapshot, atlasLayout, meshingMode));
+            }, SECTION_VOLUME, "blocks");
+        }
+    }
+}
+
+void benchmarkGeneration() {
+    std::vector<float> xs, ys, zs, values(BENCHMARK_INPUTS);
+    std::mt19937 random(BENCHMARK_SEED);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    for (int i = 0; i < BENCHMARK_INPUTS; i++) {
+        xs.push_back(coordinate(random));
+        ys.push_back(coordinate(random));
+        zs.push_back(coordinate(random));
+    }
+    const FractalNoise noise { BENCHMARK_SEED, 3, 1.0f / 32.0f };
+    Benchmark::run(std::format("noise/fractal3D/{}", Noise::getInstructionSet()), [&] {
+        Noise::fractal3D(noise, xs.data(), ys.data(), zs.data(), values.data(), values.size());
+        Benchmark::doNotOptimize(values.data());
+    }, BENCHMARK_INPUTS, "samples");
+
+    const std::pair<const char*, std::unique_ptr<TerrainGenerator>> generators[] = {
+        { "flat", std::make_unique<FlatTerrainGenerator>() },
+        { "noise", std::make_unique<NoiseTerrainGenerator>(BENCHMARK_SEED) },
+    };
+    for (const auto &[name, generator] : generators) {
+        // Chunks are recycled while streaming, reusing the memory of their sections
+        Chunk chunk({0, 0, 0});
+        int32_t chunkX = 0;
+        Benchmark::run(std::format("generate/{}", name), [&] {
+            const Vec3i chunkCoordinate(chunkX++, 0, 0);
+            chunk.reset(chunkCoordinate);
+            generator->generate(chunk, chunkCoordinate);
+            Benchmark::doNotOptimize(chunk);
+        }, 1, "chunks");
+    }
+
+    const NoiseTerrainGenerator noiseGenerator(BENCHMARK_SEED);
+    Chunk terrain({0, 0, 0});
+    noiseGenerator.generate(terrain, {0, 0, 0});
+    std::vector<FeatureBlock> features;
+    Benchmark::run("generate/placeFeatures (noise)", [&] {
+        features.clear();
+        noiseGenerator.placeFeatures(terrain, {0, 0, 0}, features);
+        Benchmark::doNotOptimize(features.data());
+    }, 1, "chunks");
+    int32_t columnX = 0;
+    Benchmark::run("generate/getSkyHeights (noise)", [&] {
+        Benchmark::doNotOptimize(noiseGenerator.getSkyHeights({columnX++, 0}));
+    }, 1, "columns");
+
+    // Rows of chunks streamed in along x, each needing the features of the rows around it
+    std::vector<unsigned int> threadCounts { 1 };
+    if (std::thread::hardware_concurrency() > 1)
+        threadCounts.push_back(std::thread::hardware_concurrency());
+    for (const unsigned int threads : threadCounts) {
+        GenerationPipeline pipeline(noiseGenerator, threads);
+        Chunk chunk({0, 0, 0});
+        int32_t rowX = 0;
+        Benchmark::run(std::format("generate/pipeline ({} threads)", threads), [&] {
+            std::vector<Vec3i> row;
+            for (int32_t y = 0; y < BENCHMARK_PIPELINE_ROW_HEIGHT; y++) {
+                for (int32_t z = 0; z < BENCHMARK_PIPELINE_ROW_WIDTH; z++) {
+                    row.emplace_back(rowX, y, z);
+                }
+            }
+            while (!row.empty()) {
+                pipeline.collectResults();
+                std::erase_if(row, [&](const Vec3i chunkCoordinate) {
+                    if (!pipeline.request(chunkCoordinate))
+                        return false;
+                    chunk.reset(chunkCoordinate);
+                    pipeline.take(chunkCoordinate, chunk);
+                    Benchmark::doNotOptimize(chunk);
+                    return true;
+                });
+                std::this_thread::yield();
+            }
+            pipeline.discard([&](const Vec3i chunkCoordinate) { return chunkCoordinate.x < rowX - FEATURE_REACH_CHUNKS; });
+            rowX++;
+        }, BENCHMARK_PIPELINE_ROW_WIDTH * BENCHMARK_PIPELINE_ROW_HEIGHT, "chunks");
+    }
+}
+
+void benchmarkLighting() {
+    // Noise chunks -1 to 1 on x and z and 0 to 2 on y, the one at the center of the bottom layer being lit again
+    const NoiseTerrainGenerator generator(BENCHMARK_SEED);
+    LightEngine engine;
+    std::optional<Chunk> center;
+    for (int32_t y = 2; y >= 0; y--) {
+        for (int32_t x = -1; x <= 1; x++) {
+            for (int32_t z = -1; z <= 1; z++) {
+                Chunk chunk({x, y, z});
+                generator.generate(chunk, {x, y, z});
+                if (x == 0 && y == 0 && z == 0)
+                    center = chunk.copyBlocks();
+                const HeightMap skyHeights = generator.getSkyHeights({x, z});
+                SkyColumns openSky;
+                for (int32_t column = 0; column < CHUNK_SIZE * CHUNK_SIZE; column++) {
+                    openSky[column] = skyHeights[column] <= chunk.getOrigin().y + CHUNK_HEIGHT;
+                }
+                engine.loadChunk(std::move(chunk), openSky);
+            }
+        }
+    }
+    Benchmark::run("light/loadChunk (noise)", [&] {
+        engine.loadChunk(center->copyBlocks(), {});
+        Benchmark::doNotOptimize(engine.collectUpdates());
+    }, 1, "chunks");
+
+    // A light source placed then removed below the surface, in an air pocket dug out of the terrain
+    const Vec3i min(8, 4, 8);
+    const Vec3i max(23, 8, 23);
+    engine.setBlocks(min, max, std::vector<block_id>((max.x - min.x + 1) * (max.y - min.y + 1) * (max.z - min.z + 1)));
+    Benchmark::doNotOptimize(engine.collectUpdates());
+    int32_t index = 0;
+    Benchmark::run("light/setBlock (light source)", [&] {
+        const block_id id = index++ % 2 == 0 ? Blocks::TEST.id : Blocks::AIR.id;
+        engine.setBlocks({16, 4, 16}, {16, 4, 16}, std::span<const block_id>(&id, 1));
+        Benchmark::doNotOptimize(engine.collectUpdates());
+    });
+}
+
+void benchmarkStorage() {
+    Chunk chunk({0, 0, 0});
+    NoiseTerrainGenerator(BENCHMARK_SEED).generate(chunk, {0, 0, 0});
+    const std::vector<uint8_t> bytes = chunk.serialize();
+    Benchmark::run(std::format("storage/serialize ({} bytes)", bytes.size()), [&chunk] {
+        Benchmark::doNotOptimize(chunk.serialize());
+    }, 1, "chunks");
+    Benchmark::run("storage/deserialize", [&] {
+        Chunk loaded({0, 0, 0});
+        Benchmark::doNotOptimize(loaded.deserialize(bytes));
+    }, 1, "chunks");
+
+    // Copies of the chunk spread over a region, saved and loaded in turn
+    std::vector<Chunk> chunks;
+    for (int32_t i = 0; i < BENCHMARK_SAVED_CHUNKS; i++) {
+        chunks.emplace_back(Vec3i(i % REGION_SIZE, 0, i / REGION_SIZE));
+        chunks.back().deserialize(bytes);
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "voxels_bench_saves";
+    std::filesystem::remove_all(directory);
+    {
+        RegionStorage storage(directory);
+        size_t index = 0;
+        Benchmark::run("storage/saveChunk", [&] {
+            storage.saveChunk(chunks[index++ % chunks.size()]);
+        }, 1, "chunks");
+
+        index = 0;
+        Benchmark::run("storage/loadChunk", [&] {
+            Chunk loaded(chunks[index++ % chunks.size()].getChunkCoordinate());
+            Benchmark::doNotOptimize(storage.loadChunk(loaded));
+        }, 1, "chunks");
+    }
+    {
+        // Time spent by the render thread, the chunk being written in the background
+        World world(std::make_unique<FlatTerrainGenerator>(), std::make_unique<RegionStorage>(directory), 1);
+        while (!world.updateLoadedChunks({0, 0, 0})) {}
+        int32_t index = 0;
+        Benchmark::run("storage/autosave (1 edited chunk)", [&] {
+            world.setBlock({0, 20, 0}, index++ % 2 == 0 ? Blocks::STONE : Blocks::AIR);
+            Benchmark::doNotOptimize(world.autosave());
+        }, 1, "saves");
+    }
+    std::filesystem::remove_all(directory);
+}
+
+std::vector<Vec3i> randomBlockPositions(std::mt19937 &random, const int32_t yMin, const int32_t yMax) {
+    // The default world spans chunks -1 to 1 on x and z
+    std::uniform_int_distribution<int32_t> horizontal(-CHUNK_SIZE, 2 * CHUNK_SIZE - 1);
+    std::uniform_int_distribution<int32_t> vertical(yMin, yMax - 1);
+    std::vector<Vec3i> positions;
+    positions.reserve(BENCHMARK_INPUTS);
+    for (int i = 0; i < BENCHMARK_INPUTS; i++) {
+        positions.emplace_back(horizontal(random), vertical(random), horizontal(random));
+    }
+    return positions;
+}
+
+void benchmarkWorldQueries(World &world) {
+    std::mt19937 random(BENCHMARK_SEED);
+
+    const std::vector<Vec3i> positions = randomBlockPositions(random, 0, CHUNK_HEIGHT);
+    size_t index = 0;
+    Benchmark::run("world/getBlock", [&] {
+        Benchmark::doNotOptimize(world.getBlock(positions[index++ % positions.size()]));
+    });
+
+    // Toggles blocks above the floor between stone and air
+    const std::vector<Vec3i> airPositions = randomBlockPositions(random, 12, CHUNK_HEIGHT);
+    index = 0;
+    Benchmark::run("world/setBlock", [&] {
+        const Vec3i &pos = airPositions[index % airPositions.size()];
+        world.setBlock(pos, (index++ / airPositions.size()) % 2 == 0 ? Blocks::STONE : Blocks::AIR);
+    });
+
+    // A quarter of the positions are in loaded chunks
+    std::uniform_int_distribution<int32_t> chunkCoordinate(-3 * CHUNK_SIZE, 3 * CHUNK_SIZE - 1);
+    std::vector<Vec3i> mapPositions;
+    mapPositions.reserve(BENCHMARK_INPUTS);
+    for (int i = 0; i < BENCHMARK_INPUTS; i++) {
+        mapPositions.emplace_back(chunkCoordinate(random), 0, chunkCoordinate(random));
+    }
+    index = 0;
+    Benchmark::run("chunkmap/isInWorld", [&] {
+        Benchmark::doNotOptimize(world.isInWorld(mapPositions[index++ % mapPositions.size()]));
+    });
+}
+
+void benchmarkChunkMap() {
+    // Square areas of loaded chunks, queried at random coordinates of which a quarter are loaded
+    for (const int32_t width : {16, 128}) {
+        ChunkMap chunks;
+        for (int32_t x = 0; x < width; x++) {
+            for (int32_t z = 0; z < width; z++) {
+                chunks.insert({x - width / 2, 0, z - width / 2});
+            }
+        }
+
+        std::mt19937 random(BENCHMARK_SEED);
+        std::uniform_int_distribution<int32_t> coordinate(-width, width - 1);
+        std::vector<Vec3i> queries;
+        queries.reserve(BENCHMARK_INPUTS);
+        for (int i = 0; i < BENCHMARK_INPUTS; i++) {
+            queries.emplace_back(coordinate(random), 0, coordinate(random));
+        }
+
+        size_t index = 0;
+        Benchmark::run(std::format("chunkmap/find ({} chunks)", chunks.size()), [&] {
+            Benchmark::doNotOptimize(chunks.find(queries[index++ % queries.size()]));
+        });
+
+        // A chunk loading then unloading, outside the loaded area
+        int32_t x = width;
+        Benchmark::run(std::format("chunkmap/recycle ({} chunks)", chunks.size()), [&] {
+            chunks.insert({x, 0, 0});
+            chunks.recycle(chunks.remove({x, 0, 0}));
+            x++;
+        });
+    }
+}
+
+void benchmarkBulkEdit() {
+    // Chunks -1 to 1 on x and z, edited across chunk borders and above the floor
+    World world(std::make_unique<FlatTerrainGenerator>(), nullptr, 1);
+    while (!world.updateLoadedChunks({0, 0, 0})) {}
+    const Vec3i min(-24, 12, -24);
+    const Vec3i max(39, 43, 39);
+    const double boxVolume = (max.x - min.x + 1) * (max.y - min.y + 1) * (max.z - min.z + 1);
+
+    // Each operation toggles the box between stone and air, so every block changes
+    int32_t index = 0;
+    Benchmark::run("edit/setBlock box", [&] {
+        const block_id id = index++ % 2 == 0 ? Blocks::STONE.id : Blocks::AIR.id;
+        for (int32_t x = min.x; x <= max.x; x++) {
+            for (int32_t y = min.y; y <= max.y; y++) {
+                for (int32_t z = min.z; z <= max.z; z++) {
+                    world.setBlock({x, y, z}, id);
+                }
+            }
+        }
+    }, boxVolume, "blocks");
+
+    for (const bool parallel : {false, true}) {
+        const char* threads = parallel ? "parallel" : "single thread";
+        index = 0;
+        Benchmark::run(std::format("edit/fillBox ({})", threads), [&] {
+            WorldEdit edit(world, parallel);
+            Benchmark::doNotOptimize(edit.fillBox(min, max, index++ % 2 == 0 ? Blocks::STONE.id : Blocks::AIR.id));
+        }, boxVolume, "blocks");
+
+        index = 0;
+        Benchmark::run(std::format("edit/replace ({})", threads), [&] {
+            WorldEdit edit(world, parallel);
+            const bool toGrass = index++ % 2 == 0;
+            Benchmark::doNotOptimize(edit.replace(min, max, toGrass ? Blocks::STONE.id : Blocks::GRASS.id,
+                toGrass ? Blocks::GRASS.id : Blocks::STONE.id));
+        }, boxVolume, "blocks");
+    }
+
+    index = 0;
+    Benchmark::run("edit/fillSphere (radius 15)", [&] {
+        WorldEdit edit(world);
+        Benchmark::doNotOptimize(edit.fillSphere({8, 28, 8}, 15, index++ % 2 == 0 ? Blocks::STONE.id : Blocks::AIR.id));
+    });
+
+    // A checkerboard pasted one block further every other time, so every block changes
+    BlockBuffer buffer({ max.x - min.x + 1, max.y - min.y + 1, max.z - min.z + 1 });
+    const Vec3i size = buffer.getSize();
+    for (int32_t x = 0; x < size.x; x++) {
+        for (int32_t y = 0; y < size.y; y++) {
+            for (int32_t z = 0; z < size.z; z++) {
+                buffer.set({x, y, z}, (x + y + z) % 2 == 0 ? Blocks::STONE.id : Blocks::AIR.id);
+            }
+        }
+    }
+    index = 0;
+    Benchmark::run("edit/paste", [&] {
+        WorldEdit edit(world);
+        Benchmark::doNotOptimize(edit.paste({min.x + index++ % 2, min.y, min.z}, buffer));
+    }, boxVolume, "blocks");
+}
+
+void benchmarkRayCast(const World &world) {
+    std::mt19937 random(BENCHMARK_SEED);
+    std::uniform_real_distribution<float> horizontal(-CHUNK_SIZE, 2 * CHUNK_SIZE);
+    std::uniform_real_distribution<float> vertical(12.0f, 40.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+
+    std::vector<Ray> rays;
+    rays.reserve(BENCHMARK_INPUTS);
+    while (rays.size() < BENCHMARK_INPUTS) {
+        const glm::vec3 direction(component(random), component(random), component(random));
+        if (glm::length(direction) < 0.01f)
+            continue;
+        rays.emplace_back(glm::vec3(horizontal(random), vertical(random), horizontal(random)), glm::normalize(direction));
+    }
+
+    size_t index = 0;
+    Benchmark::run("world/rayCast", [&] {
+        Benchmark::doNotOptimize(world.rayCast(rays[index++ % rays.size()]));
+    }, 1, "rays");
+}
+
+void benchmarkCollisions(const World &world) {
+    // Boxes gathered by the player standing on the floor and moving for one tick
+    std::mt19937 random(BENCHMARK_SEED);
+    std::uniform_real_distribution<float> horizontal(-CHUNK_SIZE, 2 * CHUNK_SIZE);
+    std::uniform_real_distribution<float> movement(-0.3f, 0.3f);
+
+    std::vector<std::pair<Vec3i, Vec3i>> ranges;
+    ranges.reserve(BENCHMARK_INPUTS);
+    for (int i = 0; i < BENCHMARK_INPUTS; i++) {
+        const glm::vec3 position(horizontal(random), 11.0f, horizontal(random));
+        const Vec3i currentBlockPos(position);
+        const Vec3i finalBlockPos(position + glm::vec3(movement(random), movement(random), movement(random)));
+        ranges.emplace_back(
+            Vec3i(std::min(currentBlockPos.x, finalBlockPos.x) - 1, std::min(currentBlockPos.y, finalBlockPos.y) - 1,
+                std::min(currentBlockPos.z, finalBlockPos.z) - 1),
+            Vec3i(std::max(currentBlockPos.x, finalBlockPos.x) + 1, std::max(currentBlockPos.y, finalBlockPos.y) + 2,
+                std::max(currentBlockPos.z, finalBlockPos.z) + 1)
+        );
+    }
+
+    size_t index = 0;
+    Benchmark::run("collision/getCollisionBoxes", [&] {
+        const auto &[min, max] = ranges[index++ % ranges.size()];
+        Benchmark::doNotOptimize(world.getCollisionBoxes(min, max));
+    }, 1, "queries");
+}
+
+int main(const int argc, char* argv[]) {
+    if (argc > 1)
+        Benchmark::setFilter(argv[1]);
+
+    const AtlasLayout atlasLayout = createAtlasLayout();
+    // Chunks -1 to 1 on x and z, and -2 to 2 on y
+    World world(std::make_unique<FlatTerrainGenerator>(), nullptr, 1);
+    while (!world.updateLoadedChunks({0, 0, 0})) {}
+
+    Benchmark::printHeader();
+    benchmarkGeneration();
+    benchmarkMeshing(atlasLayout);
+    benchmarkLighting();
+    benchmarkStorage();
+    benchmarkRayCast(world);
+    benchmarkCollisions(world);
+    benchmarkChunkMap();
+    benchmarkBulkEdit();
+    // Last, as setBlock changes the world
+    benchmarkWorldQueries(world);
+    return 0;
+}
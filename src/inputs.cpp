@@ -40,6 +40,23 @@ void InputManager::onKey(int key, int scancode, int action, int mods) {
         glfwSwapInterval(swapInterval);
     }
 
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) {
+        switch (world.getMeshingMode()) {
+            case MeshingMode::NAIVE:
+                world.setMeshingMode(MeshingMode::GREEDY);
+                Logger::info("Meshing mode: greedy");
+                break;
+            case MeshingMode::GREEDY:
+                world.setMeshingMode(MeshingMode::BINARY);
+                Logger::info("Meshing mode: binary");
+                break;
+            case MeshingMode::BINARY:
+                world.setMeshingMode(MeshingMode::NAIVE);
+                Logger::info("Meshing mode: naive");
+                break;
+        }
+    }
+
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
         if (cursorFree) {
             cursorFree = false;
@@ -2,9 +2,6 @@
 
 #include <iostream>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
 void Logger::info(const std::string &msg) {
     std::cout << "[INFO] " << msg << std::endl;
 }
@@ -20,7 +17,6 @@ void Logger::error(const std::string &msg) {
 void Logger::crash(const std::string &msg) {
     std::cerr << "The game has crashed !" << std::endl;
     std::cerr << msg << std::endl;
-    glfwTerminate();
     exit(1);
 }
 
@@ -5,22 +5,32 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstdlib>
+#include <format>
+#include <memory>
+#include <utility>
+
 #include "fpsCounter.hpp"
 #include "tickCounter.hpp"
 #include "camera.hpp"
 #include "world/world.hpp"
+#include "world/noise.hpp"
+#include "render/worldRenderer.hpp"
 #include "inputs.hpp"
 #include "hud.hpp"
 #include "texturemanip/atlas.hpp"
 #include "logger.hpp"
 
-int main() {
-    // Check block ID configuration
-    ensureCorrectBlockIDs();
+#define WORLD_SEED 1337
+#define SAVE_DIRECTORY "saves/world"
+#define AUTOSAVE_INTERVAL_TICKS (30 * TICKS_PER_SECOND)
 
+int main() {
     if (!glfwInit()) {
         Logger::crash("Error during GLFW initialization.");
     }
+    // Also terminates GLFW when the game crashes
+    std::atexit(glfwTerminate);
 
     glfwSetErrorCallback([](int error, const char* description) {
         Logger::error("[GLFW Error]: " + std::string(description));
@@ -63,9 +73,24 @@ int main() {
     TickCounter tickCounter;
     FpsCounter fpsCounter(window, tickCounter, 0.5);
 
+    // Declared before the world, whose mesh workers read the atlas layout until the world joins them
+    Atlas atlas("assets/textures/atlas.png", GL_TEXTURE0);
+    atlas.registerTextureUV("test", {0, 0, 16, 16});
+    atlas.registerTextureUV("stone", {0, 16, 16, 16});
+    atlas.registerTextureUV("grass_top", {16, 16, 16, 16});
+    atlas.registerTextureUV("grass_sides", {16, 0, 16, 16});
+    atlas.registerTextureUV("log_top", {32, 0, 16, 16});
+    atlas.registerTextureUV("log_sides", {48, 0, 16, 16});
+    atlas.registerTextureUV("leaves", {32, 16, 16, 16});
+    atlas.getLayout().validateBlockFaceTextures();
+
     Camera camera(window);
-    Player player(camera, glm::vec3(0.0, 12.0, 0.0));
-    World world;
+    auto generator = std::make_unique<NoiseTerrainGenerator>(WORLD_SEED);
+    // Above the highest terrain, the player falls onto the ground once it is loaded
+    Player player(camera, glm::vec3(0.0, generator->getMaxHeight(), 0.0));
+    World world(std::move(generator), std::make_unique<RegionStorage>(SAVE_DIRECTORY));
+    Logger::info(std::string("Terrain noise instruction set: ") + Noise::getInstructionSet());
+    WorldRenderer worldRenderer;
     Hud hud(window);
 
     InputManager input(window, world, camera, player, hud);
@@ -87,17 +112,23 @@ int main() {
         Logger::warn("Raw mouse motion is not available on this system.");
     }
 
-    Atlas atlas("assets/textures/atlas.png", GL_TEXTURE0);
-    atlas.registerTextureUV("test", {0, 0, 16, 16});
-    atlas.registerTextureUV("stone", {0, 16, 16, 16});
-    atlas.registerTextureUV("grass_top", {16, 16, 16, 16});
-    atlas.registerTextureUV("grass_sides", {16, 0, 16, 16});
-
+    int32_t ticksSinceAutosave = 0;
     while (!glfwWindowShouldClose(window)) {
         // TICKING BEGINNING
         if (tickCounter.shouldTick()) {
             tickCounter.tickBegin();
-            player.tickMovement(window, world);
+            // The player waits for the terrain around it to load rather than falling through it, at spawn or when
+            // moving faster than chunks load
+            const Vec3i playerChunk = blockPosToChunkPos(Vec3i(player.getPosition()));
+            if (world.updateLoadedChunks(playerChunk) || world.isAreaLoaded(playerChunk))
+                player.tickMovement(window, world);
+            else
+                player.holdStill();
+            if (++ticksSinceAutosave == AUTOSAVE_INTERVAL_TICKS) {
+                ticksSinceAutosave = 0;
+                if (const int32_t saved = world.autosave(); saved > 0)
+                    Logger::info(std::format("Autosaving {} chunks", saved));
+            }
             tickCounter.tickDone();
         }
         // TICKING END
@@ -110,7 +141,7 @@ int main() {
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        world.draw(camera, atlas);
+        worldRenderer.draw(world, camera, atlas);
 
         glClear(GL_DEPTH_BUFFER_BIT); // We want hud elements to always be drawn on top of world elements
 
@@ -122,6 +153,7 @@ int main() {
         glfwPollEvents();
     }
 
-    glfwTerminate();
+    // The world writes the remaining chunks when destroyed
+    Logger::info(std::format("Saving {} chunks", world.saveChunks()));
     return 0;
 }
@@ -10,4 +10,6 @@ enum class BlockFace {
     WEST
 };
 
+#define BLOCK_FACE_COUNT 6
+
 #endif
\ No newline at end of file
@@ -46,14 +46,3 @@ bool Vec2i::operator==(const Vec2i &other) const {
     return x == other.x && y == other.y;
 }
 
-
-
-size_t std::hash<Vec3i>::operator()(const Vec3i &vec) const noexcept {
-    hash<uint32_t> h;
-    return ((h(vec.x) ^ (h(vec.y) << 1)) >> 1) ^ (h(vec.z) << 1);
-}
-
-size_t std::hash<Vec2i>::operator()(const Vec2i &vec) const noexcept {
-    hash<uint32_t> h;
-    return h(vec.x) ^ (h(vec.y) << 1);
-}
@@ -33,14 +33,35 @@ struct Vec2i {
     bool operator==(const Vec2i &other) const;
 };
 
+// Finalizer of splitmix64: every input bit affects every output bit, so nearby or symmetric
+// coordinates spread over the whole range of the hash.
+inline uint64_t mixBits(uint64_t bits) {
+    bits ^= bits >> 30;
+    bits *= 0xbf58476d1ce4e5b9ull;
+    bits ^= bits >> 27;
+    bits *= 0x94d049bb133111ebull;
+    bits ^= bits >> 31;
+    return bits;
+}
+
+inline uint64_t packCoordinates(const int32_t a, const int32_t b) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32 | static_cast<uint32_t>(b);
+}
+
+// Inline, as chunk lookups hash a coordinate on every block query
 template<>
 struct std::hash<Vec2i> {
-    size_t operator()(const Vec2i &vec) const noexcept;
+    size_t operator()(const Vec2i &vec) const noexcept {
+        return mixBits(packCoordinates(vec.x, vec.y));
+    }
 };
 
 template<>
 struct std::hash<Vec3i> {
-    size_t operator()(const Vec3i &vec) const noexcept;
+    size_t operator()(const Vec3i &vec) const noexcept {
+        // The odd multiplier spreads y over every bit before mixing, so stacked coordinates do not collide
+        return mixBits(packCoordinates(vec.x, vec.z) + static_cast<uint32_t>(vec.y) * 0x9e3779b97f4a7c15ull);
+    }
 };
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "player.hpp"
 
+#include <algorithm>
 #include <format>
 
 #include "logger.hpp"
@@ -161,6 +162,16 @@ void Player::tickMovement(GLFWwindow* window, const World &world) {
     camera.setPosition(position + glm::vec3(0.0, CAMERA_HEIGHT, 0.0));
 }
 
+void Player::holdStill() {
+    velocity = glm::vec3(0.0, 0.0, 0.0);
+    lastPosition = position;
+    camera.setPosition(position + glm::vec3(0.0, CAMERA_HEIGHT, 0.0));
+}
+
+glm::vec3 Player::getPosition() const {
+    return position;
+}
+
 void Player::moveWithCollisions(const World &world) {
     lastPosition = position;
 
@@ -217,16 +228,7 @@ vector<AABB> Player::gatherSurroundingCollisionBoxes(const World &world, const g
     const int32_t zMin = std::min(currentBlockPos.z, finalBlockPos.z) - 1;
     const int32_t zMax = std::max(currentBlockPos.z, finalBlockPos.z) + 1;
 
-    vector<AABB> collisionBoxes;
-    for (auto x = xMin; x <= xMax; x++) {
-        for (auto y = yMin; y <= yMax; y++) {
-            for (auto z = zMin; z <= zMax; z++) {
-                if (world.getBlock({x, y, z}) != Blocks::AIR)
-                    collisionBoxes.push_back(AABB::ofBlock({x, y, z}));
-            }
-        }
-    }
-    return collisionBoxes;
+    return world.getCollisionBoxes({xMin, yMin, zMin}, {xMax, yMax, zMax});
 }
 
 void Player::setFlying(const bool flying) {
@@ -38,6 +38,9 @@ public:
     void onCursorMove(double newX, double newY);
     void onKey(int key, int action);
     void tickMovement(GLFWwindow* window, const World &world);
+    // Keeps the player in place for the tick instead of moving it, and stops it.
+    void holdStill();
+    [[nodiscard]] glm::vec3 getPosition() const;
 };
 
 #endif //VOXELS_PLAYER_HPP
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "render/quadIndexBuffer.hpp"
+
+#include <vector>
+
+QuadIndexBuffer::QuadIndexBuffer() {
+    glGenBuffers(1, &EBO);
+    reserve(INITIAL_QUAD_INDEX_CAPACITY);
+}
+
+void QuadIndexBuffer::reserve(const uint32_t quadCount) {
+    if (quadCount <= capacity)
+        return;
+
+    uint32_t newCapacity = capacity == 0 ? quadCount : capacity;
+    while (newCapacity < quadCount)
+        newCapacity *= 2;
+
+    std::vector<uint32_t> indices;
+    indices.reserve(newCapacity * 6);
+    for (uint32_t quad = 0; quad < newCapacity; quad++) {
+        const uint32_t first = quad * 4;
+        indices.insert(indices.end(), {
+            first, first + 1, first + 2,
+            first + 2, first + 1, first + 3,
+        });
+    }
+
+    // Upload through the copy target so the element buffer binding of the current VAO is left untouched.
+    // VAOs that already reference the buffer keep working since the buffer name does not change.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    capacity = newCapacity;
+}
+
+void QuadIndexBuffer::bind() const {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+}
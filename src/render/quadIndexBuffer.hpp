@@ -0,0 +1,28 @@
+#ifndef VOXELS_QUADINDEXBUFFER_HPP
+#define VOXELS_QUADINDEXBUFFER_HPP
+
+#include <glad/gl.h>
+
+#define INITIAL_QUAD_INDEX_CAPACITY 16384
+
+/**
+ * Element buffer shared by all meshes made of quads of 4 vertices each. Quad i is drawn as
+ * the triangles (4i, 4i+1, 4i+2) and (4i+2, 4i+1, 4i+3).
+ */
+class QuadIndexBuffer {
+    GLuint EBO = 0;
+    uint32_t capacity = 0; // In quads
+
+public:
+    QuadIndexBuffer();
+
+    QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+    QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+    // Grows the buffer so it holds indices for at least quadCount quads.
+    void reserve(uint32_t quadCount);
+    // Binds the buffer to the currently bound VAO.
+    void bind() const;
+};
+
+#endif //VOXELS_QUADINDEXBUFFER_HPP
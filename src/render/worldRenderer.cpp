@@ -0,0 +1,183 @@
+#include "render/worldRenderer.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+WorldRenderer::WorldRenderer() {
+    // Setting up shaders
+    chunkShader.use();
+    chunkShader.setIntUniform("atlas", 0);
+    highlightShader.use();
+    highlightShader.setVec4Uniform("highlightColor", 1.0f, 0.7f, 0.0f, 0.25f);
+
+    // Setting up VAO for the highlight cube
+    constexpr float cubeVertices[] = {
+        // Front face
+        0, 0, 1, 0, 0,
+        1, 0, 1, 1, 0,
+        0, 1, 1, 0, 1,
+        0, 1, 1, 0, 1,
+        1, 0, 1, 1, 0,
+        1, 1, 1, 1, 1,
+        // Back face
+        1, 0, 0, 0, 0,
+        0, 0, 0, 1, 0,
+        1, 1, 0, 0, 1,
+        1, 1, 0, 0, 1,
+        0, 0, 0, 1, 0,
+        0, 1, 0, 1, 1,
+        // Right face,
+        1, 0, 1, 0, 0,
+        1, 0, 0, 1, 0,
+        1, 1, 1, 0, 1,
+        1, 1, 1, 0, 1,
+        1, 0, 0, 1, 0,
+        1, 1, 0, 1, 1,
+        // Left face
+        0, 0, 0, 0, 0,
+        0, 0, 1, 1, 0,
+        0, 1, 0, 0, 1,
+        0, 1, 0, 0, 1,
+        0, 0, 1, 1, 0,
+        0, 1, 1, 1, 1,
+        // Top face
+        0, 1, 1, 0, 0,
+        1, 1, 1, 1, 0,
+        0, 1, 0, 0, 1,
+        0, 1, 0, 0, 1,
+        1, 1, 1, 1, 0,
+        1, 1, 0, 1, 1,
+        // Bottom face,
+        0, 0, 0, 0, 0,
+        1, 0, 0, 1, 0,
+        0, 0, 1, 0, 1,
+        0, 0, 1, 0, 1,
+        1, 0, 0, 1, 0,
+        1, 0, 1, 1, 1,
+    };
+
+    glGenVertexArrays(1, &cubeVAO);
+    glBindVertexArray(cubeVAO);
+
+    GLuint VBO;
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
+        reinterpret_cast<void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+}
+
+void WorldRenderer::draw(World &world, const Camera &camera, const Atlas &atlas) {
+    const glm::mat4 projection = camera.getProjectionMatrix();
+    const glm::mat4 view = camera.getViewMatrix();
+
+    for (const Vec3i &chunkCoordinate : world.collectUnloadedChunks()) {
+        releaseChunk(chunkCoordinate);
+    }
+    for (const MeshResult &result : world.updateMeshes(atlas.getLayout())) {
+        uploadMesh(result);
+    }
+
+    // Chunk rendering
+    chunkShader.use();
+    chunkShader.setMatrix4fUniform("projection", projection);
+    chunkShader.setMatrix4fUniform("view", view);
+    chunkShader.setVec4ArrayUniform("textureRects", atlas.getLayout().getTextureRects());
+
+    for (const auto &[pos, sections] : chunkBuffers) {
+        for (int32_t section = 0; section < SECTIONS_PER_CHUNK; section++) {
+            const SectionBuffers &buffers = sections[section];
+            if (buffers.quadCount == 0)
+                continue;
+
+            const glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(
+                pos.x * CHUNK_SIZE,
+                pos.y * CHUNK_HEIGHT + section * SECTION_HEIGHT,
+                pos.z * CHUNK_SIZE
+            ));
+            chunkShader.setMatrix4fUniform("model", model);
+            glBindVertexArray(buffers.VAO);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(buffers.quadCount * 6), GL_UNSIGNED_INT, nullptr);
+        }
+    }
+    glBindVertexArray(0);
+
+    drawHighlight(world, camera, projection, view);
+}
+
+void WorldRenderer::uploadMesh(const MeshResult &result) {
+    SectionBuffers &buffers = getChunkBuffers(result.chunkCoordinate)[result.section];
+    // Empty sections are skipped when drawing, their buffers keep any older mesh until the next one
+    if (result.mesh.empty()) {
+        buffers.quadCount = 0;
+        return;
+    }
+    if (buffers.VAO == 0) {
+        glGenVertexArrays(1, &buffers.VAO);
+        glBindVertexArray(buffers.VAO);
+        glGenBuffers(1, &buffers.VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers.VBO);
+
+        glVertexAttribIPointer(0, CHUNK_VERTEX_WORDS, GL_UNSIGNED_INT, CHUNK_VERTEX_WORDS * sizeof(uint32_t), nullptr);
+        glEnableVertexAttribArray(0);
+    }
+
+    buffers.quadCount = static_cast<uint32_t>(result.mesh.size() / (4 * CHUNK_VERTEX_WORDS));
+    quadIndices.reserve(buffers.quadCount);
+
+    glBindVertexArray(buffers.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.VBO);
+    glBufferData(GL_ARRAY_BUFFER, result.mesh.size() * sizeof(uint32_t), result.mesh.data(), GL_STATIC_DRAW);
+    quadIndices.bind();
+    glBindVertexArray(0);
+}
+
+std::array<SectionBuffers, SECTIONS_PER_CHUNK>& WorldRenderer::getChunkBuffers(const Vec3i chunkCoordinate) {
+    if (const auto it = chunkBuffers.find(chunkCoordinate); it != chunkBuffers.end())
+        return it->second;
+    if (freeChunkBuffers.empty())
+        return chunkBuffers[chunkCoordinate];
+
+    ChunkBufferMap::node_type node = std::move(freeChunkBuffers.back());
+    freeChunkBuffers.pop_back();
+    node.key() = chunkCoordinate;
+    return chunkBuffers.insert(std::move(node)).position->second;
+}
+
+void WorldRenderer::releaseChunk(const Vec3i chunkCoordinate) {
+    ChunkBufferMap::node_type node = chunkBuffers.extract(chunkCoordinate);
+    if (node.empty())
+        return;
+
+    // Sections keep their VAO and VBO, the next chunk overwrites their data
+    for (SectionBuffers &buffers : node.mapped()) {
+        buffers.quadCount = 0;
+    }
+    freeChunkBuffers.push_back(std::move(node));
+}
+
+void WorldRenderer::drawHighlight(const World &world, const Camera &camera, const glm::mat4 &projection, const glm::mat4 &view) {
+    // Ray casting for selected cube highlight
+    Ray camRay(camera.getPosition(), camera.getFrontVector());
+    std::optional<HitResult> hit = world.rayCast(camRay);
+    if (!hit)
+        return;
+
+    Vec3i blockHit = hit->blockPos;
+    glm::mat4 model(1.0f);
+    model = glm::translate(model, glm::vec3(blockHit.x, blockHit.y, blockHit.z));
+    model = glm::translate(model, glm::vec3(0.5));
+    model = glm::scale(model, glm::vec3(1.01));
+    model = glm::translate(model, glm::vec3(-0.5));
+    highlightShader.use();
+    highlightShader.setMatrix4fUniform("projection", projection);
+    highlightShader.setMatrix4fUniform("view", view);
+    highlightShader.setMatrix4fUniform("model", model);
+
+    glBindVertexArray(cubeVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glBindVertexArray(0);
+}
@@ -0,0 +1,58 @@
+#ifndef VOXELS_WORLDRENDERER_HPP
+#define VOXELS_WORLDRENDERER_HPP
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "shader.hpp"
+#include "camera.hpp"
+#include "render/quadIndexBuffer.hpp"
+#include "texturemanip/atlas.hpp"
+#include "world/world.hpp"
+
+// GPU buffers holding the mesh of a chunk section.
+struct SectionBuffers {
+    GLuint VAO = 0, VBO = 0;
+    uint32_t quadCount = 0;
+};
+
+/**
+ * Draws a World: uploads the section meshes built by the world to the GPU, draws them, and
+ * highlights the block targeted by the camera.
+ */
+class WorldRenderer {
+    Shader chunkShader {
+        "assets/shaders/chunk.vert",
+        "assets/shaders/chunk.frag"
+    };
+    Shader highlightShader {
+        "assets/shaders/highlight.vert",
+        "assets/shaders/highlight.frag"
+    };
+    GLuint cubeVAO = 0;
+    QuadIndexBuffer quadIndices;
+    using ChunkBufferMap = unordered_map<Vec3i, std::array<SectionBuffers, SECTIONS_PER_CHUNK>>;
+    ChunkBufferMap chunkBuffers;
+    // Entries of unloaded chunks, reused with their GPU buffers by the next chunks loaded
+    std::vector<ChunkBufferMap::node_type> freeChunkBuffers;
+
+    // Replaces the drawn mesh of a section. Until then, sections keep drawing their previous mesh.
+    void uploadMesh(const MeshResult &result);
+    [[nodiscard]] std::array<SectionBuffers, SECTIONS_PER_CHUNK>& getChunkBuffers(Vec3i chunkCoordinate);
+    // Stops drawing the chunk, keeping its buffers for another chunk.
+    void releaseChunk(Vec3i chunkCoordinate);
+    void drawHighlight(const World &world, const Camera &camera, const glm::mat4 &projection, const glm::mat4 &view);
+
+public:
+    WorldRenderer();
+
+    WorldRenderer(const WorldRenderer&) = delete;
+    WorldRenderer& operator=(const WorldRenderer&) = delete;
+
+    void draw(World &world, const Camera &camera, const Atlas &atlas);
+};
+
+#endif //VOXELS_WORLDRENDERER_HPP
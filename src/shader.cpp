@@ -104,3 +104,9 @@ void Shader::setVec4Uniform(const char* uniformName, float x, float y, float z,
 void Shader::setVec4Uniform(const char* uniformName, glm::vec4 vector) {
     glUniform4f(getUniformLocation(uniformName), vector.x, vector.y, vector.z, vector.w);
 }
+
+void Shader::setVec4ArrayUniform(const char* uniformName, const vector<glm::vec4> &vectors) {
+    if (vectors.empty())
+        return;
+    glUniform4fv(getUniformLocation(uniformName), static_cast<GLsizei>(vectors.size()), glm::value_ptr(vectors[0]));
+}
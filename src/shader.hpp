@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -25,6 +26,7 @@ public:
     void setVec3Uniform(const char* uniformName, glm::vec3 vector);
     void setVec4Uniform(const char* uniformName, float x, float y, float z, float w);
     void setVec4Uniform(const char* uniformName, glm::vec4 vector);
+    void setVec4ArrayUniform(const char* uniformName, const vector<glm::vec4> &vectors);
 };
 
 #endif
\ No newline at end of file
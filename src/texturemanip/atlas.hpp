@@ -2,23 +2,13 @@
 #define VOXELS_ATLAS_HPP
 
 #include <string>
-#include <unordered_map>
-
-#include <glm/glm.hpp>
 
 #include "texturemanip/texture2D.hpp"
-#include "math/vectors.hpp"
-
-struct TextureUV {
-    Vec2i start;
-    Vec2i size;
-
-    TextureUV(int32_t x, int32_t y, int32_t w, int32_t h);
-};
+#include "texturemanip/atlasLayout.hpp"
 
 class Atlas {
     Texture2D texture;
-    std::unordered_map<std::string, TextureUV> UVs;
+    AtlasLayout layout;
 
 public:
     Atlas(const std::string &path, GLenum textureUnit);
@@ -26,7 +16,7 @@ public:
 
     void registerTextureUV(const std::string &name, const TextureUV &textureUV);
 
-    void applyTextureUV(glm::vec2 & textureCoordinate, const std::string &textureName) const;
+    [[nodiscard]] const AtlasLayout& getLayout() const;
 };
 
-#endif //VOXELS_ATLAS_HPP
\ No newline at end of file
+#endif //VOXELS_ATLAS_HPP
@@ -0,0 +1,65 @@
+#include "texturemanip/atlasLayout.hpp"
+
+#include <stdexcept>
+
+#include "logger.hpp"
+#include "world/blocks.hpp"
+
+TextureUV::TextureUV(const int32_t x, const int32_t y, const int32_t w, const int32_t h) : start(x, y), size(w, h) {}
+
+AtlasLayout::AtlasLayout(const int32_t atlasWidth, const int32_t atlasHeight): atlasWidth(atlasWidth), atlasHeight(atlasHeight) {
+    resolveBlockFaceTextures();
+}
+
+void AtlasLayout::registerTextureUV(const std::string& name, const TextureUV &textureUV) {
+    if (textureIndices.contains(name))
+        return;
+    if (textureRects.size() >= MAX_ATLAS_TEXTURES)
+        Logger::crash("Too many textures in atlas, cannot register: " + name);
+
+    const auto width = static_cast<float>(atlasWidth);
+    const auto height = static_cast<float>(atlasHeight);
+
+    // Atlas pixel coordinates start at the top, texture coordinates at the bottom.
+    textureIndices.insert({name, static_cast<uint16_t>(textureRects.size())});
+    textureRects.emplace_back(
+        static_cast<float>(textureUV.start.x) / width,
+        1 - static_cast<float>(textureUV.start.y + textureUV.size.y) / height,
+        static_cast<float>(textureUV.size.x) / width,
+        static_cast<float>(textureUV.size.y) / height
+    );
+    resolveBlockFaceTextures();
+}
+
+void AtlasLayout::resolveBlockFaceTextures() {
+    blockFaceTextures.assign(BLOCK_COUNT * BLOCK_FACE_COUNT, MISSING_TEXTURE_INDEX);
+    for (int32_t i = 0; i < BLOCK_COUNT * BLOCK_FACE_COUNT; i++) {
+        const auto it = textureIndices.find(std::string(Blocks::FACE_TEXTURE_TABLE[i]));
+        if (it != textureIndices.end())
+            blockFaceTextures[i] = it->second;
+    }
+}
+
+uint16_t AtlasLayout::getTextureIndex(const std::string& textureName) const {
+    try {
+        return textureIndices.at(textureName);
+    } catch ([[maybe_unused]] const std::out_of_range& o) {
+        Logger::crash("No such texture in atlas: " + textureName);
+    }
+}
+
+void AtlasLayout::validateBlockFaceTextures() const {
+    for (int32_t i = 0; i < BLOCK_COUNT * BLOCK_FACE_COUNT; i++) {
+        const auto id = static_cast<block_id>(i / BLOCK_FACE_COUNT);
+        if (blockFaceTextures[i] == MISSING_TEXTURE_INDEX && !Blocks::isAir(id))
+            Logger::crash("No such texture in atlas: " + std::string(Blocks::FACE_TEXTURE_TABLE[i]));
+    }
+}
+
+uint16_t AtlasLayout::getBlockFaceTexture(const block_id id, const BlockFace face) const {
+    return blockFaceTextures[id * BLOCK_FACE_COUNT + static_cast<int>(face)];
+}
+
+const std::vector<glm::vec4>& AtlasLayout::getTextureRects() const {
+    return textureRects;
+}
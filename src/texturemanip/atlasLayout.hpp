@@ -0,0 +1,56 @@
+#ifndef VOXELS_ATLASLAYOUT_HPP
+#define VOXELS_ATLASLAYOUT_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "math/vectors.hpp"
+#include "math/blockface.hpp"
+#include "world/block.hpp"
+
+// Must match the size of the textureRects array in chunk.frag
+#define MAX_ATLAS_TEXTURES 64
+// Texture index of block faces whose texture is not registered yet
+#define MISSING_TEXTURE_INDEX UINT16_MAX
+
+struct TextureUV {
+    Vec2i start;
+    Vec2i size;
+
+    TextureUV(int32_t x, int32_t y, int32_t w, int32_t h);
+};
+
+/**
+ * Where textures are in the atlas, without the atlas texture itself, so meshes can be built
+ * without an OpenGL context.
+ */
+class AtlasLayout {
+    int32_t atlasWidth, atlasHeight;
+    std::unordered_map<std::string, uint16_t> textureIndices;
+    // Normalized rectangle of each texture, indexed by texture index: (u, v) of the
+    // bottom-left corner in xy, width and height in zw.
+    std::vector<glm::vec4> textureRects;
+    // Texture index of each block face, indexed by block_id * BLOCK_FACE_COUNT + face.
+    // Resolved from the block texture names whenever a texture is registered.
+    std::vector<uint16_t> blockFaceTextures;
+
+    void resolveBlockFaceTextures();
+
+public:
+    AtlasLayout(int32_t atlasWidth, int32_t atlasHeight);
+
+    void registerTextureUV(const std::string &name, const TextureUV &textureUV);
+
+    [[nodiscard]] uint16_t getTextureIndex(const std::string &textureName) const;
+    // Crashes if a face of a block other than air has no registered texture. Called on the main thread once
+    // every texture is registered, before any mesh is built.
+    void validateBlockFaceTextures() const;
+    // Texture index of a block face, without any string lookup or check, so mesh workers never crash on it.
+    [[nodiscard]] uint16_t getBlockFaceTexture(block_id id, BlockFace face) const;
+    [[nodiscard]] const std::vector<glm::vec4>& getTextureRects() const;
+};
+
+#endif //VOXELS_ATLASLAYOUT_HPP
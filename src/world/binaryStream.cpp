@@ -0,0 +1,74 @@
+#include "world/binaryStream.hpp"
+
+#include <utility>
+
+// A 32-bit value takes at most 5 bytes of 7 bits
+#define MAX_VARINT_BYTES 5
+
+void BinaryWriter::writeU8(const uint8_t value) {
+    bytes.push_back(value);
+}
+
+void BinaryWriter::writeU32(const uint32_t value) {
+    for (int32_t shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+void BinaryWriter::writeVarint(uint32_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+const std::vector<uint8_t>& BinaryWriter::getBytes() const {
+    return bytes;
+}
+
+std::vector<uint8_t> BinaryWriter::takeBytes() {
+    return std::move(bytes);
+}
+
+BinaryReader::BinaryReader(const std::span<const uint8_t> bytes): bytes(bytes) {}
+
+uint8_t BinaryReader::readU8() {
+    if (position >= bytes.size()) {
+        failed = true;
+        return 0;
+    }
+    return bytes[position++];
+}
+
+uint32_t BinaryReader::readU32() {
+    uint32_t value = 0;
+    for (int32_t shift = 0; shift < 32; shift += 8) {
+        value |= static_cast<uint32_t>(readU8()) << shift;
+    }
+    return failed ? 0 : value;
+}
+
+uint32_t BinaryReader::readVarint() {
+    uint32_t value = 0;
+    for (int32_t i = 0; i < MAX_VARINT_BYTES; i++) {
+        const uint8_t byte = readU8();
+        value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0)
+            return failed ? 0 : value;
+    }
+    failed = true;
+    return 0;
+}
+
+bool BinaryReader::hasFailed() const {
+    return failed;
+}
+
+void BinaryReader::fail() {
+    failed = true;
+}
+
+bool BinaryReader::isAtEnd() const {
+    return position == bytes.size();
+}
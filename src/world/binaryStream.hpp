@@ -0,0 +1,42 @@
+#ifndef VOXELS_BINARYSTREAM_HPP
+#define VOXELS_BINARYSTREAM_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Appends little-endian integers to a byte buffer.
+class BinaryWriter {
+    std::vector<uint8_t> bytes;
+
+public:
+    void writeU8(uint8_t value);
+    void writeU32(uint32_t value);
+    // Unsigned LEB128, 7 bits per byte: values below 128 take a single byte.
+    void writeVarint(uint32_t value);
+
+    [[nodiscard]] const std::vector<uint8_t>& getBytes() const;
+    [[nodiscard]] std::vector<uint8_t> takeBytes();
+};
+
+// Reads what BinaryWriter wrote. Reading past the end or a malformed varint returns 0 and marks the
+// reader as failed, so a whole record can be decoded before checking for errors once.
+class BinaryReader {
+    std::span<const uint8_t> bytes;
+    size_t position = 0;
+    bool failed = false;
+
+public:
+    explicit BinaryReader(std::span<const uint8_t> bytes);
+
+    [[nodiscard]] uint8_t readU8();
+    [[nodiscard]] uint32_t readU32();
+    [[nodiscard]] uint32_t readVarint();
+
+    [[nodiscard]] bool hasFailed() const;
+    // Marks the reader as failed, for values that were read fine but are invalid.
+    void fail();
+    [[nodiscard]] bool isAtEnd() const;
+};
+
+#endif //VOXELS_BINARYSTREAM_HPP
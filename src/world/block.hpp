@@ -1,26 +1,62 @@
 #ifndef VOXELS_BLOCK_HPP
 #define VOXELS_BLOCK_HPP
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "math/blockface.hpp"
 
 using namespace std;
 using block_id = uint16_t;
 
+// Shape entities collide with, 1 block wide cubes being the only one so far
+enum class CollisionShape : uint8_t {
+    NONE,
+    FULL_CUBE
+};
+
+/**
+ * Definition of a block type. Blocks are defined at compile time in blocks.hpp, which turns their
+ * definitions into dense property tables indexed by block id for hot paths.
+ */
 class Block {
 public:
     const block_id id;
-    const string topTexture;
-    const string sidesTexture;
+    const string_view topTexture;
+    const string_view sidesTexture;
+    const uint8_t lightEmission; // Block light level emitted, 0 for blocks that do not glow
+    const bool opaque; // Whether the block hides the faces of its neighbours and blocks light
+    const CollisionShape collisionShape;
 
     Block(const Block&) = delete;
     Block& operator=(const Block&) = delete;
 
-    Block(block_id id, const string &topTexture, const string &sidesTexture);
+    constexpr Block(const block_id id, const string_view topTexture, const string_view sidesTexture,
+                    const uint8_t lightEmission = 0, const bool opaque = true,
+                    const CollisionShape collisionShape = CollisionShape::FULL_CUBE):
+        id(id), topTexture(topTexture), sidesTexture(sidesTexture), lightEmission(lightEmission), opaque(opaque),
+        collisionShape(collisionShape) {}
+
+    [[nodiscard]] constexpr string_view getFaceTexture(const BlockFace face) const {
+        return face == BlockFace::UP || face == BlockFace::DOWN ? topTexture : sidesTexture;
+    }
 };
 
-bool operator==(const Block& block, block_id id);
-bool operator==(block_id id, const Block& block);
-bool operator!=(const Block& block, block_id id);
-bool operator!=(block_id id, const Block& block);
+constexpr bool operator==(const Block& block, const block_id id) {
+    return block.id == id;
+}
+
+constexpr bool operator==(const block_id id, const Block& block) {
+    return block.id == id;
+}
+
+constexpr bool operator!=(const Block& block, const block_id id) {
+    return block.id != id;
+}
+
+constexpr bool operator!=(const block_id id, const Block& block) {
+    return block.id != id;
+}
 
-#endif //VOXELS_BLOCK_HPP
\ No newline at end of file
+#endif //VOXELS_BLOCK_HPP
@@ -0,0 +1,45 @@
+#include "world/blockAccessor.hpp"
+
+#include <cstdlib>
+
+#include "world/blocks.hpp"
+#include "world/world.hpp"
+
+BlockAccessor::BlockAccessor(const World &world): world(world) {}
+
+const Chunk* BlockAccessor::moveTo(Vec3i &pos) {
+    const Vec3i target = blockPosToChunkPos(pos);
+    pos.x -= target.x * CHUNK_SIZE;
+    pos.y -= target.y * CHUNK_HEIGHT;
+    pos.z -= target.z * CHUNK_SIZE;
+    if (cached && target == chunkCoordinate)
+        return chunk;
+
+    const int32_t dx = target.x - chunkCoordinate.x;
+    const int32_t dy = target.y - chunkCoordinate.y;
+    const int32_t dz = target.z - chunkCoordinate.z;
+    if (chunk && std::abs(dx) + std::abs(dy) + std::abs(dz) == 1) {
+        const ChunkNeighbors &neighbors = chunk->getNeighbors();
+        if (dx != 0)
+            chunk = dx == 1 ? neighbors.east : neighbors.west;
+        else if (dy != 0)
+            chunk = dy == 1 ? neighbors.up : neighbors.down;
+        else
+            chunk = dz == 1 ? neighbors.south : neighbors.north;
+    } else {
+        chunk = world.getChunk(target);
+    }
+    chunkCoordinate = target;
+    cached = true;
+    return chunk;
+}
+
+block_id BlockAccessor::getBlock(Vec3i pos) {
+    const Chunk* current = moveTo(pos);
+    return current ? current->getBlockUnchecked(pos.x, pos.y, pos.z) : Blocks::AIR.id;
+}
+
+std::optional<block_id> BlockAccessor::getUniformSectionBlock(Vec3i pos) {
+    const Chunk* current = moveTo(pos);
+    return current ? current->getUniformBlock(blockYToSection(pos.y)) : Blocks::AIR.id;
+}
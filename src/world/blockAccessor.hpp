@@ -0,0 +1,35 @@
+#ifndef VOXELS_BLOCKACCESSOR_HPP
+#define VOXELS_BLOCKACCESSOR_HPP
+
+#include <optional>
+
+#include "math/vectors.hpp"
+#include "world/block.hpp"
+
+class Chunk;
+class World;
+
+/**
+ * Reads blocks of a world, caching the chunk of the last position read. Moving to an adjacent chunk
+ * follows the chunk's neighbour links, only jumps to other chunks look up the world's chunk map.
+ * An accessor must not be used after chunks are loaded or unloaded.
+ */
+class BlockAccessor {
+    const World &world;
+    const Chunk* chunk = nullptr; // nullptr when the cached chunk is not loaded
+    Vec3i chunkCoordinate {0, 0, 0};
+    bool cached = false;
+
+    // The chunk containing pos, and pos relative to it
+    const Chunk* moveTo(Vec3i &pos);
+
+public:
+    explicit BlockAccessor(const World &world);
+
+    // Air outside the loaded chunks, like World::getBlock.
+    [[nodiscard]] block_id getBlock(Vec3i pos);
+    // The block filling the whole chunk section containing pos, like World::getUniformSectionBlock.
+    [[nodiscard]] std::optional<block_id> getUniformSectionBlock(Vec3i pos);
+};
+
+#endif //VOXELS_BLOCKACCESSOR_HPP
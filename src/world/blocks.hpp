@@ -1,18 +1,101 @@
 #ifndef VOXELS_BLOCKS_HPP
 #define VOXELS_BLOCKS_HPP
 
+#include <array>
+
 #include "world/block.hpp"
 
 namespace Blocks {
-    const Block& fromId(block_id id);
-
-    const Block AIR(0, "air", "air");
-    const Block TEST(1, "test", "test");
-    const Block STONE(2, "stone", "stone");
-    const Block GRASS(3, "grass_top", "grass_sides");
+    inline constexpr Block AIR(0, "air", "air", 0, false, CollisionShape::NONE);
+    // Placed by the player, glowing like a torch
+    inline constexpr Block TEST(1, "test", "test", 14);
+    inline constexpr Block STONE(2, "stone", "stone");
+    inline constexpr Block GRASS(3, "grass_top", "grass_sides");
+    // Placed by trees, see Features
+    inline constexpr Block LOG(4, "log_top", "log_sides");
+    inline constexpr Block LEAVES(5, "leaves", "leaves");
 
+    // Every block, indexed by id
+    inline constexpr std::array<const Block*, 6> ALL = {
+        &AIR,
+        &TEST,
+        &STONE,
+        &GRASS,
+        &LOG,
+        &LEAVES,
+    };
 }
 
-void ensureCorrectBlockIDs();
+inline constexpr int32_t BLOCK_COUNT = static_cast<int32_t>(Blocks::ALL.size());
+
+namespace Blocks {
+    consteval bool haveMatchingIds() {
+        for (size_t i = 0; i < ALL.size(); i++) {
+            if (ALL[i]->id != i)
+                return false;
+        }
+        return true;
+    }
+    static_assert(haveMatchingIds(), "Block position in Blocks::ALL does not match its ID");
+
+    // Builds a dense table of a block property indexed by block id
+    template<typename T, typename Property>
+    consteval std::array<T, BLOCK_COUNT> makePropertyTable(const Property& property) {
+        std::array<T, BLOCK_COUNT> table {};
+        for (int32_t id = 0; id < BLOCK_COUNT; id++) {
+            table[id] = property(*ALL[id]);
+        }
+        return table;
+    }
+
+    // Block properties as structure of arrays, so hot paths look them up with a single array load.
+    // Ids are not range checked, blocks in chunks are validated when they are loaded.
+    inline constexpr auto AIR_TABLE = makePropertyTable<bool>([](const Block& block) { return block.id == AIR.id; });
+    inline constexpr auto OPAQUE_TABLE = makePropertyTable<bool>([](const Block& block) { return block.opaque; });
+    inline constexpr auto SOLID_TABLE = makePropertyTable<bool>([](const Block& block) {
+        return block.collisionShape != CollisionShape::NONE;
+    });
+    inline constexpr auto LIGHT_EMISSION_TABLE = makePropertyTable<uint8_t>([](const Block& block) {
+        return block.lightEmission;
+    });
+    inline constexpr auto COLLISION_SHAPE_TABLE = makePropertyTable<CollisionShape>([](const Block& block) {
+        return block.collisionShape;
+    });
+    // Texture name of each block face, indexed by block_id * BLOCK_FACE_COUNT + face
+    inline constexpr auto FACE_TEXTURE_TABLE = [] {
+        std::array<string_view, BLOCK_COUNT * BLOCK_FACE_COUNT> table {};
+        for (int32_t id = 0; id < BLOCK_COUNT; id++) {
+            for (int32_t face = 0; face < BLOCK_FACE_COUNT; face++) {
+                table[id * BLOCK_FACE_COUNT + face] = ALL[id]->getFaceTexture(static_cast<BlockFace>(face));
+            }
+        }
+        return table;
+    }();
+
+    constexpr bool isAir(const block_id id) {
+        return AIR_TABLE[id];
+    }
+
+    constexpr bool isOpaque(const block_id id) {
+        return OPAQUE_TABLE[id];
+    }
+
+    // Whether entities collide with the block
+    constexpr bool isSolid(const block_id id) {
+        return SOLID_TABLE[id];
+    }
+
+    constexpr uint8_t getLightEmission(const block_id id) {
+        return LIGHT_EMISSION_TABLE[id];
+    }
+
+    constexpr CollisionShape getCollisionShape(const block_id id) {
+        return COLLISION_SHAPE_TABLE[id];
+    }
+
+    constexpr string_view getFaceTexture(const block_id id, const BlockFace face) {
+        return FACE_TEXTURE_TABLE[id * BLOCK_FACE_COUNT + static_cast<int32_t>(face)];
+    }
+}
 
-#endif //VOXELS_BLOCKS_HPP
\ No newline at end of file
+#endif //VOXELS_BLOCKS_HPP
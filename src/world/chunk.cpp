@@ -1,104 +1,40 @@
 #include "world/chunk.hpp"
 
-#include <unordered_map>
-#include <format>
-
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 
+#include "world/binaryStream.hpp"
 #include "world/blocks.hpp"
+#include "world/sectionSnapshot.hpp"
 #include "logger.hpp"
 
-const unordered_map<BlockFace, array<float, 30>> quads = {
-    { BlockFace::SOUTH, {
-        0, 0, 1, 0, 0,
-        1, 0, 1, 1, 0,
-        0, 1, 1, 0, 1,
-        0, 1, 1, 0, 1,
-        1, 0, 1, 1, 0,
-        1, 1, 1, 1, 1,
-    }},
-    { BlockFace::NORTH, {
-        1, 0, 0, 0, 0,
-        0, 0, 0, 1, 0,
-        1, 1, 0, 0, 1,
-        1, 1, 0, 0, 1,
-        0, 0, 0, 1, 0,
-        0, 1, 0, 1, 1,
-    }},
-    { BlockFace::EAST, {
-        1, 0, 1, 0, 0,
-        1, 0, 0, 1, 0,
-        1, 1, 1, 0, 1,
-        1, 1, 1, 0, 1,
-        1, 0, 0, 1, 0,
-        1, 1, 0, 1, 1,
-    }},
-    { BlockFace::WEST, {
-        0, 0, 0, 0, 0,
-        0, 0, 1, 1, 0,
-        0, 1, 0, 0, 1,
-        0, 1, 0, 0, 1,
-        0, 0, 1, 1, 0,
-        0, 1, 1, 1, 1,
-    }},
-    { BlockFace::UP, {
-        0, 1, 1, 0, 0,
-        1, 1, 1, 1, 0,
-        0, 1, 0, 0, 1,
-        0, 1, 0, 0, 1,
-        1, 1, 1, 1, 0,
-        1, 1, 0, 1, 1,
-    }},
-    { BlockFace::DOWN, {
-        0, 0, 0, 0, 0,
-        1, 0, 0, 1, 0,
-        0, 0, 1, 0, 1,
-        0, 0, 1, 0, 1,
-        1, 0, 0, 1, 0,
-        1, 0, 1, 1, 1,
-    }}
-};
-
-Chunk::Chunk(const Vec2i chunkCoordinate): chunkCoordinate(chunkCoordinate) {
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-        reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
-
-    // Initialize the content array with air.
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                setBlock({x, y, z}, Blocks::AIR);
-            }
-        }
-    }
+// Bumped when the serialized layout changes, older chunks are then regenerated
+#define CHUNK_FORMAT_VERSION 2
 
-    // Make a floor
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y <= 10; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                setBlock({x, y, z}, y == 10 ? Blocks::GRASS : Blocks::STONE);
-            }
-        }
+Chunk::Chunk(const Vec3i chunkCoordinate): chunkCoordinate(chunkCoordinate) {
+    // Sections start filled with air
+    markMeshDirty();
+}
+
+void Chunk::reset(const Vec3i chunkCoordinate) {
+    this->chunkCoordinate = chunkCoordinate;
+    for (SectionStorage &section : sections) {
+        section.clear();
     }
+    sectionLights = {};
+    lightReady = false;
+    lightLoad = 0;
+    sectionMeshes = {};
+    neighbors = {};
+    unsavedChanges = false;
+    markMeshDirty();
+}
 
-    setBlock({0, 11, 0}, Blocks::TEST);
-    setBlock({CHUNK_SIZE - 1, 11, 0}, Blocks::TEST);
-    setBlock({0, 11, CHUNK_SIZE - 1}, Blocks::TEST);
-    setBlock({CHUNK_SIZE - 1, 11, CHUNK_SIZE - 1}, Blocks::TEST);
+Vec3i Chunk::getChunkCoordinate() const {
+    return chunkCoordinate;
+}
+
+Vec3i Chunk::getOrigin() const {
+    return chunkPosToBlockPos(chunkCoordinate);
 }
 
 block_id Chunk::getBlock(const Vec3i& pos) const {
@@ -107,7 +43,11 @@ block_id Chunk::getBlock(const Vec3i& pos) const {
             || pos.z < 0 || pos.z >= CHUNK_SIZE)
         Logger::crash("Block position out of range in chunk");
 
-    return content[pos.x][pos.z][pos.y];
+    return sections[blockYToSection(pos.y)].get(pos.x, pos.y % SECTION_HEIGHT, pos.z);
+}
+
+block_id Chunk::getBlockUnchecked(const int32_t x, const int32_t y, const int32_t z) const {
+    return sections[y / SECTION_HEIGHT].get(x, y % SECTION_HEIGHT, z);
 }
 
 void Chunk::setBlock(const Vec3i& pos, const Block& block) {
@@ -120,81 +60,372 @@ void Chunk::setBlock(const Vec3i& pos, const block_id id) {
             || pos.z < 0 || pos.z >= CHUNK_SIZE)
         Logger::crash("Block position out of range in chunk");
 
-    content[pos.x][pos.z][pos.y] = id;
-    recomputeMeshPending = true;
-}
-
-
-void Chunk::recomputeMesh(const Atlas& atlas) {
-    const double start = glfwGetTime();
-
-    mesh.clear();
-
-    for (int32_t x = 0; x < CHUNK_SIZE; x++) {
-        for (int32_t y = 0; y < CHUNK_HEIGHT; y++) {
-            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
-                Vec3i blockPos(x, y, z);
-                const block_id bid = getBlock(blockPos);
-                if (bid != Blocks::AIR) {
-                    for (auto [blockFace, quadVertices] : quads) {
-                        Vec3i neighbor = blockPos.offset(blockFace);
-                        if (neighbor.x < 0
-                            || neighbor.x >= CHUNK_SIZE
-                            || neighbor.y < 0
-                            || neighbor.y >= CHUNK_HEIGHT
-                            || neighbor.z < 0
-                            || neighbor.z >= CHUNK_SIZE
-                            || getBlock(neighbor) == Blocks::AIR)
-                        {
-                            const Block &block = Blocks::fromId(bid);
-                            const string &textureName = blockFace == BlockFace::DOWN || blockFace == BlockFace::UP ? block.topTexture : block.sidesTexture;
-                            for (int i = 0; i < 30; i += 5) {
-                                quadVertices[i] += static_cast<float>(x);
-                                quadVertices[i + 1] += static_cast<float>(y);
-                                quadVertices[i + 2] += static_cast<float>(z);
-
-                                glm::vec2 textureCoords(quadVertices[i + 3], quadVertices[i + 4]);
-                                atlas.applyTextureUV(textureCoords, textureName);
-                                quadVertices[i + 3] = textureCoords.x,
-                                quadVertices[i + 4] = textureCoords.y;
-                            }
-                            mesh.insert(mesh.end(), quadVertices.begin(), quadVertices.end());
-                        }
-                    }
-                }
-            }
+    const int32_t section = pos.y / SECTION_HEIGHT;
+    sections[section].set(pos.x, pos.y % SECTION_HEIGHT, pos.z, id);
+    unsavedChanges = true;
+
+    // Blocks on a section border hide or reveal faces of the adjacent section. Both bounds of the adjacent
+    // section are checked, the compiler cannot tell section is in range otherwise.
+    markSectionMeshDirty(section);
+    const int32_t below = section - 1;
+    const int32_t above = section + 1;
+    if (pos.y % SECTION_HEIGHT == 0 && below >= 0 && below < SECTIONS_PER_CHUNK)
+        markSectionMeshDirty(below);
+    if (pos.y % SECTION_HEIGHT == SECTION_HEIGHT - 1 && above >= 0 && above < SECTIONS_PER_CHUNK)
+        markSectionMeshDirty(above);
+}
+
+void Chunk::copyColumn(const int32_t x, const int32_t z, int32_t yMin, int32_t yMax, block_id* out) const {
+    if (yMin < 0) {
+        out -= yMin;
+        yMin = 0;
+    }
+    yMax = std::min(yMax, CHUNK_HEIGHT);
+
+    while (yMin < yMax) {
+        const int32_t section = blockYToSection(yMin);
+        const int32_t sectionBase = section * SECTION_HEIGHT;
+        const int32_t sectionYMax = std::min(yMax, sectionBase + SECTION_HEIGHT);
+        sections[section].copyColumn(x, z, yMin - sectionBase, sectionYMax - sectionBase, out);
+        out += sectionYMax - yMin;
+        yMin = sectionYMax;
+    }
+}
+
+int32_t Chunk::fillBox(const Vec3i min, const Vec3i max, const block_id id) {
+    int32_t changed = 0;
+    for (int32_t section = blockYToSection(min.y); section <= blockYToSection(max.y); section++) {
+        const int32_t sectionBase = section * SECTION_HEIGHT;
+        changed += sections[section].fillBox(
+            { min.x, std::max(min.y - sectionBase, 0), min.z },
+            { max.x, std::min(max.y - sectionBase, SECTION_HEIGHT - 1), max.z },
+            id
+        );
+    }
+    unsavedChanges = unsavedChanges || changed > 0;
+    return changed;
+}
+
+int32_t Chunk::replace(const Vec3i min, const Vec3i max, const block_id from, const block_id to) {
+    int32_t changed = 0;
+    for (int32_t section = blockYToSection(min.y); section <= blockYToSection(max.y); section++) {
+        const int32_t sectionBase = section * SECTION_HEIGHT;
+        changed += sections[section].replace(
+            { min.x, std::max(min.y - sectionBase, 0), min.z },
+            { max.x, std::min(max.y - sectionBase, SECTION_HEIGHT - 1), max.z },
+            from, to
+        );
+    }
+    unsavedChanges = unsavedChanges || changed > 0;
+    return changed;
+}
+
+int32_t Chunk::pasteColumn(const int32_t x, const int32_t z, int32_t yMin, int32_t yMax, const block_id* blocks,
+        const bool skipAir) {
+    if (yMin < 0) {
+        blocks -= yMin;
+        yMin = 0;
+    }
+    yMax = std::min(yMax, CHUNK_HEIGHT);
+
+    int32_t changed = 0;
+    while (yMin < yMax) {
+        const int32_t section = blockYToSection(yMin);
+        const int32_t sectionBase = section * SECTION_HEIGHT;
+        const int32_t sectionYMax = std::min(yMax, sectionBase + SECTION_HEIGHT);
+        changed += sections[section].pasteColumn(x, z, yMin - sectionBase, sectionYMax - sectionBase, blocks, skipAir);
+        blocks += sectionYMax - yMin;
+        yMin = sectionYMax;
+    }
+    unsavedChanges = unsavedChanges || changed > 0;
+    return changed;
+}
+
+std::vector<block_id> Chunk::copyBox(const Vec3i min, const Vec3i max) const {
+    const int32_t height = max.y - min.y + 1;
+    std::vector<block_id> blocks(static_cast<size_t>(max.x - min.x + 1) * (max.z - min.z + 1) * height);
+    block_id* out = blocks.data();
+    for (int32_t x = min.x; x <= max.x; x++) {
+        for (int32_t z = min.z; z <= max.z; z++) {
+            copyColumn(x, z, min.y, max.y + 1, out);
+            out += height;
         }
     }
+    return blocks;
+}
+
+void Chunk::copyLightColumn(const int32_t x, const int32_t z, int32_t yMin, const int32_t yMax, uint8_t* out) const {
+    for (; yMin < 0 && yMin < yMax; yMin++) {
+        *out++ = 0;
+    }
+    while (yMin < std::min(yMax, CHUNK_HEIGHT)) {
+        const int32_t section = blockYToSection(yMin);
+        const int32_t sectionBase = section * SECTION_HEIGHT;
+        const int32_t sectionYMax = std::min(yMax, sectionBase + SECTION_HEIGHT);
+        sectionLights[section].copyColumn(x, z, yMin - sectionBase, sectionYMax - sectionBase, out);
+        out += sectionYMax - yMin;
+        yMin = sectionYMax;
+    }
+    for (; yMin < yMax; yMin++) {
+        *out++ = FULL_SKY_LIGHT;
+    }
+}
 
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, mesh.size() * sizeof(float), mesh.data(), GL_STATIC_DRAW);
-    glBindVertexArray(0);
+void Chunk::setSectionLight(const int32_t section, SectionLight light) {
+    sectionLights[section] = std::move(light);
+}
+
+bool Chunk::isLightReady() const {
+    return lightReady;
+}
+
+void Chunk::markLightReady() {
+    lightReady = true;
+}
+
+uint64_t Chunk::getLightLoad() const {
+    return lightLoad;
+}
 
-    const double end = glfwGetTime();
-    Logger::info(std::format("Mesh building took {:.3f} milliseconds", (end - start) * 1000));
+void Chunk::setLightLoad(const uint64_t lightLoad) {
+    this->lightLoad = lightLoad;
 }
 
-void Chunk::draw(Shader &shader, const Atlas& atlas) {
-    if (recomputeMeshPending) {
-        recomputeMeshPending = false;
-        recomputeMesh(atlas);
+std::optional<block_id> Chunk::getUniformBlock(const int32_t section) const {
+    const SectionStorage &storage = sections[section];
+    if (!storage.isUniform())
+        return std::nullopt;
+    return storage.getUniformBlock();
+}
+
+size_t Chunk::memoryUsage() const {
+    size_t total = sizeof(Chunk);
+    for (const SectionStorage &section : sections) {
+        total += section.memoryUsage() - sizeof(SectionStorage);
     }
+    for (const SectionLight &light : sectionLights) {
+        total += light.memoryUsage() - sizeof(SectionLight);
+    }
+    return total;
+}
 
-    const glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(
-        chunkCoordinate.x * CHUNK_SIZE,
-        0,
-        chunkCoordinate.y * CHUNK_SIZE
-    ));
-    shader.use();
-    shader.setMatrix4fUniform("model", model);
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, mesh.size() / 5);
-    glBindVertexArray(0);
+const ChunkNeighbors& Chunk::getNeighbors() const {
+    return neighbors;
+}
+
+void Chunk::setNeighbor(const BlockFace side, const Chunk* neighbor) {
+    switch (side) {
+        case BlockFace::NORTH:
+            neighbors.north = neighbor;
+            break;
+        case BlockFace::SOUTH:
+            neighbors.south = neighbor;
+            break;
+        case BlockFace::EAST:
+            neighbors.east = neighbor;
+            break;
+        case BlockFace::WEST:
+            neighbors.west = neighbor;
+            break;
+        case BlockFace::UP:
+            neighbors.up = neighbor;
+            break;
+        case BlockFace::DOWN:
+            neighbors.down = neighbor;
+            break;
+    }
 }
 
-Vec2i blockPosToChunkPos(const Vec3i blockPos) {
+bool Chunk::hasUnsavedChanges() const {
+    return unsavedChanges;
+}
+
+void Chunk::markSaved() {
+    unsavedChanges = false;
+}
+
+Chunk Chunk::copyBlocks() const {
+    Chunk copy(chunkCoordinate);
+    copy.sections = sections;
+    return copy;
+}
+
+void Chunk::copyBlocksFrom(const Chunk &other) {
+    sections = other.sections;
+    markMeshDirty();
+}
+
+std::vector<uint8_t> Chunk::serialize() const {
+    BinaryWriter writer;
+    writer.writeU8(CHUNK_FORMAT_VERSION);
+    for (const SectionStorage &section : sections) {
+        section.write(writer);
+    }
+    return writer.takeBytes();
+}
+
+bool Chunk::deserialize(const std::span<const uint8_t> bytes) {
+    BinaryReader reader(bytes);
+    bool valid = reader.readU8() == CHUNK_FORMAT_VERSION;
+    for (SectionStorage &section : sections) {
+        valid = valid && section.read(reader);
+    }
+    valid = valid && reader.isAtEnd();
+
+    if (!valid)
+        sections = {};
+    unsavedChanges = false;
+    markMeshDirty();
+    return valid;
+}
+
+void Chunk::markMeshDirty() {
+    for (SectionMeshState &sectionMesh : sectionMeshes) {
+        sectionMesh.recomputeMeshPending = true;
+    }
+}
+
+void Chunk::markSectionMeshDirty(const int32_t section) {
+    sectionMeshes[section].recomputeMeshPending = true;
+}
+
+bool Chunk::needsMeshJob(const int32_t section) const {
+    const SectionMeshState &sectionMesh = sectionMeshes[section];
+    return sectionMesh.recomputeMeshPending && sectionMesh.pendingMeshJob == 0;
+}
+
+bool Chunk::hasEmptyMesh(const int32_t section, const ChunkNeighbors& neighbors) const {
+    const std::optional<block_id> block = getUniformBlock(section);
+    if (!block)
+        return false;
+    if (Blocks::isAir(*block))
+        return true;
+
+    // Faces of a solid section are hidden only if every surrounding section is uniformly opaque.
+    // Sections of chunks that are not loaded count as air.
+    const auto isOpaque = [](const Chunk* chunk, const int32_t index) {
+        if (!chunk)
+            return false;
+        const std::optional<block_id> uniform = chunk->getUniformBlock(index);
+        return uniform && Blocks::isOpaque(*uniform);
+    };
+    const bool belowOpaque = section > 0
+        ? isOpaque(this, section - 1) : isOpaque(neighbors.down, SECTIONS_PER_CHUNK - 1);
+    const bool aboveOpaque = section < SECTIONS_PER_CHUNK - 1
+        ? isOpaque(this, section + 1) : isOpaque(neighbors.up, 0);
+    return Blocks::isOpaque(*block) && belowOpaque && aboveOpaque
+        && isOpaque(neighbors.north, section) && isOpaque(neighbors.south, section)
+        && isOpaque(neighbors.east, section) && isOpaque(neighbors.west, section);
+}
+
+void Chunk::skipMeshJob(const int32_t section) {
+    sectionMeshes[section].recomputeMeshPending = false;
+}
+
+// Adjacent chunk along an axis, 0 for x, 1 for y and 2 for z, towards negative or positive coordinates
+const Chunk* getNeighbor(const ChunkNeighbors& neighbors, const int32_t axis, const int32_t direction) {
+    switch (axis) {
+        case 0: return direction < 0 ? neighbors.west : neighbors.east;
+        case 1: return direction < 0 ? neighbors.down : neighbors.up;
+        default: return direction < 0 ? neighbors.north : neighbors.south;
+    }
+}
+
+// Chunk offset by -1, 0 or 1 along each axis from the chunk with the given neighbours, reached through the
+// links of the loaded chunks in between, in any order of the axes. nullptr when none of them leads to it.
+const Chunk* getLinkedChunk(const ChunkNeighbors& neighbors, const Vec3i offset) {
+    const std::array<int32_t, 3> offsets { offset.x, offset.y, offset.z };
+    std::array<int32_t, 3> axes { 0, 1, 2 };
+    do {
+        const ChunkNeighbors* links = &neighbors;
+        const Chunk* chunk = nullptr;
+        for (const int32_t axis : axes) {
+            if (offsets[axis] == 0)
+                continue;
+            chunk = getNeighbor(*links, axis, offsets[axis]);
+            if (!chunk)
+                break;
+            links = &chunk->getNeighbors();
+        }
+        if (chunk)
+            return chunk;
+    } while (std::next_permutation(axes.begin(), axes.end()));
+    return nullptr;
+}
+
+// Range of snapshot x or z taken from the chunk at the given offset along that axis
+int32_t borderStart(const int32_t offset) {
+    return offset < 0 ? -1 : offset * CHUNK_SIZE;
+}
+
+int32_t borderEnd(const int32_t offset) {
+    return offset > 0 ? CHUNK_SIZE : offset * CHUNK_SIZE + CHUNK_SIZE - 1;
+}
+
+std::unique_ptr<SectionSnapshot> Chunk::createMeshSnapshot(const int32_t section, const ChunkNeighbors& neighbors,
+        const uint64_t meshJob) {
+    SectionMeshState &sectionMesh = sectionMeshes[section];
+    sectionMesh.recomputeMeshPending = false;
+    sectionMesh.pendingMeshJob = meshJob;
+
+    // The snapshot includes one layer of blocks below and above the section
+    const int32_t yMin = section * SECTION_HEIGHT - 1;
+    const int32_t yMax = yMin + SECTION_HEIGHT + 2;
+
+    // The section and its border columns, from the adjacent chunks including the diagonal ones, whose blocks
+    // occlude the corners of faces along the chunk's edges. Columns of chunks that are not loaded are left as
+    // dark air. The bottom and top layers cross into the chunks below and above at the chunk's borders.
+    auto snapshot = std::make_unique<SectionSnapshot>();
+    for (int32_t dx = -1; dx <= 1; dx++) {
+        for (int32_t dz = -1; dz <= 1; dz++) {
+            const Chunk* chunk = dx == 0 && dz == 0 ? this : getLinkedChunk(neighbors, {dx, 0, dz});
+            const Chunk* below = section == 0 ? getLinkedChunk(neighbors, {dx, -1, dz}) : nullptr;
+            const Chunk* above = section == SECTIONS_PER_CHUNK - 1 ? getLinkedChunk(neighbors, {dx, 1, dz}) : nullptr;
+            for (int32_t snapshotX = borderStart(dx); snapshotX <= borderEnd(dx); snapshotX++) {
+                for (int32_t snapshotZ = borderStart(dz); snapshotZ <= borderEnd(dz); snapshotZ++) {
+                    const int32_t x = snapshotX - dx * CHUNK_SIZE;
+                    const int32_t z = snapshotZ - dz * CHUNK_SIZE;
+                    block_id* blocks = snapshot->column(snapshotX, snapshotZ);
+                    uint8_t* lights = snapshot->lightColumn(snapshotX, snapshotZ);
+                    if (chunk) {
+                        chunk->copyColumn(x, z, yMin, yMax, blocks);
+                        chunk->copyLightColumn(x, z, yMin, yMax, lights);
+                    }
+                    if (below) {
+                        below->copyColumn(x, z, CHUNK_HEIGHT - 1, CHUNK_HEIGHT, blocks);
+                        below->copyLightColumn(x, z, CHUNK_HEIGHT - 1, CHUNK_HEIGHT, lights);
+                    }
+                    if (above) {
+                        above->copyColumn(x, z, 0, 1, blocks + SECTION_HEIGHT + 1);
+                        above->copyLightColumn(x, z, 0, 1, lights + SECTION_HEIGHT + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+bool Chunk::completeMeshJob(const int32_t section, const uint64_t meshJob) {
+    SectionMeshState &sectionMesh = sectionMeshes[section];
+    if (sectionMesh.pendingMeshJob != meshJob)
+        return false;
+    sectionMesh.pendingMeshJob = 0;
+    return true;
+}
+
+Vec3i blockPosToChunkPos(const Vec3i blockPos) {
     const int32_t chunkX = blockPos.x >= 0 ? (blockPos.x / CHUNK_SIZE) : ((blockPos.x + 1) / CHUNK_SIZE) - 1;
+    const int32_t chunkY = blockPos.y >= 0 ? (blockPos.y / CHUNK_HEIGHT) : ((blockPos.y + 1) / CHUNK_HEIGHT) - 1;
     const int32_t chunkZ = blockPos.z >= 0 ? (blockPos.z / CHUNK_SIZE) : ((blockPos.z + 1) / CHUNK_SIZE) - 1;
-    return {chunkX, chunkZ};
+    return {chunkX, chunkY, chunkZ};
+}
+
+Vec3i chunkPosToBlockPos(const Vec3i chunkCoordinate) {
+    return { chunkCoordinate.x * CHUNK_SIZE, chunkCoordinate.y * CHUNK_HEIGHT, chunkCoordinate.z * CHUNK_SIZE };
+}
+
+int32_t blockYToSection(const int32_t y) {
+    return y >= 0 ? y / SECTION_HEIGHT : ((y + 1) / SECTION_HEIGHT) - 1;
 }
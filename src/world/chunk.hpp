@@ -1,34 +1,135 @@
 #ifndef CHUNK_HPP
 #define CHUNK_HPP
 
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
-#include "shader.hpp"
 #include "math/vectors.hpp"
 #include "world/block.hpp"
-#include "texturemanip/atlas.hpp"
+#include "world/chunkDimensions.hpp"
+#include "world/sectionLight.hpp"
+#include "world/sectionStorage.hpp"
 
-#define CHUNK_SIZE 32
-#define CHUNK_HEIGHT 64
+class SectionSnapshot;
+class Chunk;
 
-class Chunk {
-    Vec2i chunkCoordinate;
-    block_id content[CHUNK_SIZE][CHUNK_SIZE][CHUNK_HEIGHT];
-    vector<float> mesh {};
-    GLuint VAO = 0, VBO = 0;
+// Chunks adjacent to a chunk, nullptr where no chunk is loaded.
+struct ChunkNeighbors {
+    const Chunk* north = nullptr; // Towards -z
+    const Chunk* south = nullptr; // Towards +z
+    const Chunk* east = nullptr; // Towards +x
+    const Chunk* west = nullptr; // Towards -x
+    const Chunk* up = nullptr; // Towards +y
+    const Chunk* down = nullptr; // Towards -y
+};
+
+// Mesh state of a vertical section of a chunk, rebuilt independently of the other sections.
+struct SectionMeshState {
     bool recomputeMeshPending = false;
+    uint64_t pendingMeshJob = 0; // Id of the job building a mesh from a snapshot of this section, 0 when none
+};
 
-    void recomputeMesh(const Atlas& atlas);
+class Chunk {
+    Vec3i chunkCoordinate;
+    std::array<SectionStorage, SECTIONS_PER_CHUNK> sections;
+    std::array<SectionLight, SECTIONS_PER_CHUNK> sectionLights;
+    std::array<SectionMeshState, SECTIONS_PER_CHUNK> sectionMeshes;
+    ChunkNeighbors neighbors;
+    bool unsavedChanges = false;
+    bool lightReady = false;
+    uint64_t lightLoad = 0; // Id of the light engine's load of this chunk, 0 before it is queued
 
 public:
-    explicit Chunk(Vec2i chunkCoordinate);
+    explicit Chunk(Vec3i chunkCoordinate);
+
+    // Chunks hold several kilobytes of blocks, copies are explicit with copyBlocks
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+    Chunk(Chunk&&) = default;
+    Chunk& operator=(Chunk&&) = default;
+
+    // Reuses the chunk at another coordinate, filled with air, keeping the memory of its sections.
+    void reset(Vec3i chunkCoordinate);
+    [[nodiscard]] Vec3i getChunkCoordinate() const;
+    // World position of the chunk's block at (0, 0, 0).
+    [[nodiscard]] Vec3i getOrigin() const;
     [[nodiscard]] block_id getBlock(const Vec3i& pos) const;
+    // Chunk-relative position, with no bounds checks.
+    [[nodiscard]] block_id getBlockUnchecked(int32_t x, int32_t y, int32_t z) const;
     void setBlock(const Vec3i& pos, block_id id);
     void setBlock(const Vec3i& pos, const Block& block);
+    // Copies the blocks of the column at x, z with y from yMin (inclusive) to yMax (exclusive) into out,
+    // from bottom to top. Entries of out for y outside the chunk are left untouched.
+    void copyColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, block_id* out) const;
+    // The blocks between min and max, both inclusive and chunk-relative, column after column like copyColumn.
+    [[nodiscard]] std::vector<block_id> copyBox(Vec3i min, Vec3i max) const;
+    // Bulk edits of the box between min and max, both inclusive and chunk-relative, returning the number of
+    // blocks changed. Unlike setBlock they leave the mesh state alone, the caller marks edited sections dirty.
+    int32_t fillBox(Vec3i min, Vec3i max, block_id id);
+    int32_t replace(Vec3i min, Vec3i max, block_id from, block_id to);
+    // Copies blocks into the column at x, z, the reverse of copyColumn, skipping air when skipAir is set.
+    // Like the other bulk edits, returns the number of blocks changed and leaves the mesh state alone.
+    int32_t pasteColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, const block_id* blocks, bool skipAir);
+    // The block filling the whole section, if it is uniform.
+    [[nodiscard]] std::optional<block_id> getUniformBlock(int32_t section) const;
+    [[nodiscard]] size_t memoryUsage() const;
+
+    // Light computed by the world's light engine, full sky light until then. Like copyColumn, but entries for y
+    // above the chunk get full sky light and entries below it no light.
+    void copyLightColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, uint8_t* out) const;
+    void setSectionLight(int32_t section, SectionLight light);
+    // Whether the light of the whole chunk has been computed since it was loaded.
+    [[nodiscard]] bool isLightReady() const;
+    void markLightReady();
+    // Id the world gave the load of the chunk into its light engine. Light updates of other loads, queued before
+    // the chunk was unloaded and loaded again, are outdated.
+    [[nodiscard]] uint64_t getLightLoad() const;
+    void setLightLoad(uint64_t lightLoad);
+
+    // Links to the loaded adjacent chunks, kept up to date by the world as chunks load and unload.
+    [[nodiscard]] const ChunkNeighbors& getNeighbors() const;
+    void setNeighbor(BlockFace side, const Chunk* neighbor);
+
+    // Whether blocks changed since the chunk was last saved or loaded. Generated chunks have unsaved changes.
+    [[nodiscard]] bool hasUnsavedChanges() const;
+    void markSaved();
+    // A chunk with the same blocks, a fresh mesh state, no light, no neighbour links and no unsaved changes.
+    [[nodiscard]] Chunk copyBlocks() const;
+    // Replaces the blocks of the chunk with the blocks of other, reusing the memory of its sections.
+    void copyBlocksFrom(const Chunk &other);
+    // Serializes the blocks of the chunk, compressed per section.
+    [[nodiscard]] std::vector<uint8_t> serialize() const;
+    // Replaces the blocks of the chunk with serialized ones. Returns false on malformed data, leaving the
+    // chunk filled with air.
+    bool deserialize(std::span<const uint8_t> bytes);
+
+    void markMeshDirty();
+    void markSectionMeshDirty(int32_t section);
 
-    void draw(Shader &shader, const Atlas& atlas);
+    // Whether the section's mesh is outdated and no mesh job is already running for it.
+    [[nodiscard]] bool needsMeshJob(int32_t section) const;
+    // Whether the section is known to have no visible faces without meshing it: it is uniform air,
+    // or uniformly opaque and enclosed by uniformly opaque sections.
+    [[nodiscard]] bool hasEmptyMesh(int32_t section, const ChunkNeighbors& neighbors) const;
+    // Marks the section's mesh as up to date without running a mesh job, for sections with an empty mesh.
+    void skipMeshJob(int32_t section);
+    // Snapshots the blocks and light of a section for the mesh job with the given id, which must not be 0.
+    // Neighbors are used to cull faces against blocks of adjacent chunks, including the chunks above and below
+    // for the bottom and top sections.
+    [[nodiscard]] std::unique_ptr<SectionSnapshot> createMeshSnapshot(int32_t section, const ChunkNeighbors& neighbors,
+        uint64_t meshJob);
+    // Called once a mesh job of the section has finished. Returns false when it is not the section's pending
+    // job, started before the chunk was unloaded and loaded again, its mesh then being outdated.
+    bool completeMeshJob(int32_t section, uint64_t meshJob);
 };
 
-Vec2i blockPosToChunkPos(Vec3i blockPos);
+Vec3i blockPosToChunkPos(Vec3i blockPos);
+// World position of the block at (0, 0, 0) in the chunk.
+Vec3i chunkPosToBlockPos(Vec3i chunkCoordinate);
+// Section containing y, counting sections from world height 0, or from the bottom of a chunk for chunk-relative y.
+int32_t blockYToSection(int32_t y);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,17 @@
+#ifndef VOXELS_CHUNKDIMENSIONS_HPP
+#define VOXELS_CHUNKDIMENSIONS_HPP
+
+// Chunks are cubes, stacked vertically as well as horizontally
+#define CHUNK_SIZE 32
+#define CHUNK_HEIGHT CHUNK_SIZE
+#define SECTION_HEIGHT 16
+#define SECTIONS_PER_CHUNK (CHUNK_HEIGHT / SECTION_HEIGHT)
+
+// Vertical chunk coordinates of the lowest and highest chunks of the world, both inclusive. Only the chunks
+// near the player are loaded, so the world height does not cost any memory.
+#define WORLD_MIN_CHUNK_Y (-64)
+#define WORLD_MAX_CHUNK_Y 63
+#define WORLD_MIN_Y (WORLD_MIN_CHUNK_Y * CHUNK_HEIGHT)
+#define WORLD_MAX_Y ((WORLD_MAX_CHUNK_Y + 1) * CHUNK_HEIGHT - 1)
+
+#endif //VOXELS_CHUNKDIMENSIONS_HPP
@@ -0,0 +1,98 @@
+#include "world/chunkMap.hpp"
+
+#include <utility>
+
+#include "logger.hpp"
+
+// Power of two, so slot indices are hashes masked by the capacity minus one
+#define INITIAL_CAPACITY 64
+
+ChunkMap::ChunkMap(): slots(INITIAL_CAPACITY) {}
+
+size_t ChunkMap::homeSlot(const Vec3i chunkCoordinate) const {
+    return std::hash<Vec3i>()(chunkCoordinate) & (slots.size() - 1);
+}
+
+size_t ChunkMap::findSlot(const Vec3i chunkCoordinate) const {
+    const size_t mask = slots.size() - 1;
+    size_t index = homeSlot(chunkCoordinate);
+    while (slots[index].chunk) {
+        const Vec3i &slotCoordinate = slots[index].chunkCoordinate;
+        if (slotCoordinate.x == chunkCoordinate.x && slotCoordinate.y == chunkCoordinate.y
+                && slotCoordinate.z == chunkCoordinate.z)
+            break;
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void ChunkMap::grow() {
+    std::vector<Slot> previous = std::exchange(slots, std::vector<Slot>(slots.size() * 2));
+    for (Slot &slot : previous) {
+        if (slot.chunk)
+            slots[findSlot(slot.chunkCoordinate)] = slot;
+    }
+}
+
+Chunk* ChunkMap::find(const Vec3i chunkCoordinate) {
+    return slots[findSlot(chunkCoordinate)].chunk;
+}
+
+const Chunk* ChunkMap::find(const Vec3i chunkCoordinate) const {
+    return slots[findSlot(chunkCoordinate)].chunk;
+}
+
+bool ChunkMap::contains(const Vec3i chunkCoordinate) const {
+    return find(chunkCoordinate) != nullptr;
+}
+
+Chunk& ChunkMap::insert(const Vec3i chunkCoordinate) {
+    if ((count + 1) * 2 > slots.size())
+        grow();
+
+    Slot &slot = slots[findSlot(chunkCoordinate)];
+    if (slot.chunk)
+        Logger::crash("Chunk inserted twice in the chunk map");
+
+    slot.chunkCoordinate = chunkCoordinate;
+    slot.chunk = pool.acquire(chunkCoordinate);
+    count++;
+    return *slot.chunk;
+}
+
+Chunk* ChunkMap::remove(const Vec3i chunkCoordinate) {
+    size_t hole = findSlot(chunkCoordinate);
+    Chunk* chunk = std::exchange(slots[hole].chunk, nullptr);
+    if (!chunk)
+        return nullptr;
+    count--;
+
+    // Moves back the following slots of the probe sequence that would no longer be reachable past the hole
+    const size_t mask = slots.size() - 1;
+    for (size_t index = (hole + 1) & mask; slots[index].chunk; index = (index + 1) & mask) {
+        const size_t home = homeSlot(slots[index].chunkCoordinate);
+        // Whether home is cyclically within (hole, index], in which case the slot stays
+        const bool reachable = hole < index ? home > hole && home <= index : home > hole || home <= index;
+        if (!reachable) {
+            slots[hole] = std::exchange(slots[index], Slot());
+            hole = index;
+        }
+    }
+    return chunk;
+}
+
+void ChunkMap::recycle(Chunk* chunk) {
+    pool.release(chunk);
+}
+
+size_t ChunkMap::size() const {
+    return count;
+}
+
+ChunkMap::Iterator ChunkMap::begin() {
+    return { slots.begin(), slots.end() };
+}
+
+ChunkMap::Iterator ChunkMap::end() {
+    return { slots.end(), slots.end() };
+}
@@ -0,0 +1,74 @@
+#ifndef VOXELS_CHUNKMAP_HPP
+#define VOXELS_CHUNKMAP_HPP
+
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/chunk.hpp"
+#include "world/chunkPool.hpp"
+
+/**
+ * Hash map from chunk coordinates to loaded chunks, with open addressing and linear probing. Slots hold
+ * the coordinate next to the chunk pointer, so a lookup usually reads a single cache line. The table is
+ * kept at most half full, and erasing shifts the following slots back instead of leaving tombstones.
+ * Chunks come from a pool, so pointers to them stay valid until they are recycled.
+ */
+class ChunkMap {
+    struct Slot {
+        Vec3i chunkCoordinate {0, 0, 0};
+        Chunk* chunk = nullptr; // nullptr for empty slots
+    };
+
+    ChunkPool pool;
+    std::vector<Slot> slots;
+    size_t count = 0;
+
+    [[nodiscard]] size_t homeSlot(Vec3i chunkCoordinate) const;
+    // Slot holding the chunk, or the empty slot ending its probe sequence
+    [[nodiscard]] size_t findSlot(Vec3i chunkCoordinate) const;
+    void grow();
+
+public:
+    class Iterator {
+        std::vector<Slot>::iterator slot;
+        std::vector<Slot>::iterator end;
+
+        void skipEmptySlots() {
+            while (slot != end && !slot->chunk)
+                ++slot;
+        }
+
+    public:
+        Iterator(const std::vector<Slot>::iterator slot, const std::vector<Slot>::iterator end): slot(slot), end(end) {
+            skipEmptySlots();
+        }
+
+        Chunk& operator*() const { return *slot->chunk; }
+        Iterator& operator++() {
+            ++slot;
+            skipEmptySlots();
+            return *this;
+        }
+        bool operator!=(const Iterator &other) const { return slot != other.slot; }
+    };
+
+    ChunkMap();
+
+    // nullptr when the chunk is not in the map.
+    [[nodiscard]] Chunk* find(Vec3i chunkCoordinate);
+    [[nodiscard]] const Chunk* find(Vec3i chunkCoordinate) const;
+    [[nodiscard]] bool contains(Vec3i chunkCoordinate) const;
+    // Adds an empty chunk, which must not already be in the map.
+    Chunk& insert(Vec3i chunkCoordinate);
+    // Removes the chunk from the map, nullptr when it is not in the map. The chunk stays valid until recycled.
+    [[nodiscard]] Chunk* remove(Vec3i chunkCoordinate);
+    // Returns a removed chunk to the pool, for reuse by the next insertions.
+    void recycle(Chunk* chunk);
+    [[nodiscard]] size_t size() const;
+
+    // Iterates over the chunks in no particular order. The map must not be modified while iterating.
+    [[nodiscard]] Iterator begin();
+    [[nodiscard]] Iterator end();
+};
+
+#endif //VOXELS_CHUNKMAP_HPP
@@ -0,0 +1,348 @@
+#include "world/chunkMesher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include "world/blocks.hpp"
+
+// Describes how the quad of a block face is laid out. Axes are indices into a position
+// (0 = x, 1 = y, 2 = z). The texture's u and v coordinates run along uAxis and vAxis,
+// in the direction given by uSign and vSign.
+struct FaceLayout {
+    BlockFace face;
+    int normalAxis;
+    bool positive; // Whether the face is on the positive side of the block along normalAxis
+    int uAxis;
+    int uSign;
+    int vAxis;
+    int vSign;
+};
+
+constexpr std::array<FaceLayout, 6> FACE_LAYOUTS = {{
+    { BlockFace::SOUTH, 2, true, 0, +1, 1, +1 },
+    { BlockFace::NORTH, 2, false, 0, -1, 1, +1 },
+    { BlockFace::EAST, 0, true, 2, -1, 1, +1 },
+    { BlockFace::WEST, 0, false, 2, +1, 1, +1 },
+    { BlockFace::UP, 1, true, 0, +1, 2, -1 },
+    { BlockFace::DOWN, 1, false, 0, +1, 2, +1 },
+}};
+
+constexpr int32_t SECTION_DIMENSIONS[3] = { CHUNK_SIZE, SECTION_HEIGHT, CHUNK_SIZE };
+
+// Snapshot columns include the border blocks around the section
+constexpr int32_t PADDED_CHUNK_SIZE = CHUNK_SIZE + 2;
+constexpr int32_t PADDED_SECTION_HEIGHT = SECTION_HEIGHT + 2;
+
+// Bits of a snapshot column, bit i being set when the block at y = i - 1 has some property
+using ColumnMask = uint32_t;
+static_assert(PADDED_SECTION_HEIGHT <= 32, "Snapshot columns must fit in a ColumnMask");
+
+// Ambient occlusion of each vertex of a face, 2 bits per vertex in the order p00, p10, p01, p11
+// (see emitFace), from 0 (fully occluded) to 3 (unoccluded)
+using FaceOcclusion = uint8_t;
+
+constexpr uint32_t getVertexOcclusion(const FaceOcclusion occlusion, const int vertex) {
+    return occlusion >> (vertex * 2) & 3;
+}
+
+constexpr uint32_t vertexOcclusion(const bool side1, const bool side2, const bool corner) {
+    // Both sides hide the corner block, the vertex being occluded as much as possible
+    if (side1 && side2)
+        return 0;
+    return 3 - side1 - side2 - corner;
+}
+
+/**
+ * Computes the ambient occlusion of the vertices of a block face from the blocks surrounding the block
+ * in front of it. opaqueAt(du, dv) tells whether the block du steps from the front block along the
+ * direction from p00 to p10, and dv steps along the direction from p00 to p01, is opaque.
+ */
+template<typename OpaqueAt>
+FaceOcclusion computeFaceOcclusion(const OpaqueAt& opaqueAt) {
+    const bool uLow = opaqueAt(-1, 0);
+    const bool uHigh = opaqueAt(1, 0);
+    const bool vLow = opaqueAt(0, -1);
+    const bool vHigh = opaqueAt(0, 1);
+    return static_cast<FaceOcclusion>(
+        vertexOcclusion(uLow, vLow, opaqueAt(-1, -1))
+        | vertexOcclusion(uHigh, vLow, opaqueAt(1, -1)) << 2
+        | vertexOcclusion(uLow, vHigh, opaqueAt(-1, 1)) << 4
+        | vertexOcclusion(uHigh, vHigh, opaqueAt(1, 1)) << 6);
+}
+
+// Snapshot position of the block du and dv steps away from pos along the u and v directions of a face
+Vec3i offsetAlongFace(const FaceLayout& layout, const Vec3i& pos, const int32_t du, const int32_t dv) {
+    int32_t coords[3] = { pos.x, pos.y, pos.z };
+    coords[layout.uAxis] += du * layout.uSign;
+    coords[layout.vAxis] += dv * layout.vSign;
+    return { coords[0], coords[1], coords[2] };
+}
+
+FaceOcclusion computeFaceOcclusion(const SectionSnapshot& snapshot, const FaceLayout& layout, const Vec3i& front) {
+    return computeFaceOcclusion([&](const int32_t du, const int32_t dv) {
+        return Blocks::isOpaque(snapshot.getBlock(offsetAlongFace(layout, front, du, dv)));
+    });
+}
+
+void pushVertex(vector<uint32_t>& mesh, const Vec3i& pos, const uint32_t u, const uint32_t v, const uint16_t textureIndex,
+                const uint8_t light, const uint32_t occlusion) {
+    mesh.push_back(pos.x | pos.y << 6 | pos.z << 13 | static_cast<uint32_t>(light) << 19 | occlusion << 27);
+    mesh.push_back(u | v << 7 | static_cast<uint32_t>(textureIndex) << 16);
+}
+
+/**
+ * Appends the quad of a face covering a width * height rectangle of blocks.
+ * The rectangle starts at block coordinates (u, v) along the layout's u and v axes, in the
+ * given layer along its normal axis. Texture coordinates are expressed in tiles so the
+ * texture repeats once per block. The face is lit by the light of the blocks in front of it and
+ * darkened at its corners by their ambient occlusion.
+ */
+void emitFace(vector<uint32_t>& mesh, const FaceLayout& layout, const int32_t layer, const int32_t u, const int32_t v,
+              const int32_t width, const int32_t height, const uint16_t textureIndex, const uint8_t light,
+              const FaceOcclusion occlusion) {
+    int32_t origin[3];
+    origin[layout.normalAxis] = layout.positive ? layer + 1 : layer;
+    origin[layout.uAxis] = layout.uSign > 0 ? u : u + width;
+    origin[layout.vAxis] = layout.vSign > 0 ? v : v + height;
+
+    int32_t uCorner[3] = { origin[0], origin[1], origin[2] };
+    uCorner[layout.uAxis] += layout.uSign * width;
+    int32_t vCorner[3] = { origin[0], origin[1], origin[2] };
+    vCorner[layout.vAxis] += layout.vSign * height;
+    int32_t uvCorner[3] = { uCorner[0], uCorner[1], uCorner[2] };
+    uvCorner[layout.vAxis] += layout.vSign * height;
+
+    const Vec3i p00(origin[0], origin[1], origin[2]);
+    const Vec3i p10(uCorner[0], uCorner[1], uCorner[2]);
+    const Vec3i p01(vCorner[0], vCorner[1], vCorner[2]);
+    const Vec3i p11(uvCorner[0], uvCorner[1], uvCorner[2]);
+    const auto w = static_cast<uint32_t>(width);
+    const auto h = static_cast<uint32_t>(height);
+
+    const uint32_t ao00 = getVertexOcclusion(occlusion, 0);
+    const uint32_t ao10 = getVertexOcclusion(occlusion, 1);
+    const uint32_t ao01 = getVertexOcclusion(occlusion, 2);
+    const uint32_t ao11 = getVertexOcclusion(occlusion, 3);
+
+    // QuadIndexBuffer splits quads along the diagonal between their second and third vertices.
+    // Occlusion is interpolated across each triangle, so the quad is split along its brightest
+    // diagonal, which keeps the shading symmetric. Both orders keep the same winding.
+    if (ao00 + ao11 > ao10 + ao01) {
+        pushVertex(mesh, p10, w, 0, textureIndex, light, ao10);
+        pushVertex(mesh, p11, w, h, textureIndex, light, ao11);
+        pushVertex(mesh, p00, 0, 0, textureIndex, light, ao00);
+        pushVertex(mesh, p01, 0, h, textureIndex, light, ao01);
+    } else {
+        pushVertex(mesh, p00, 0, 0, textureIndex, light, ao00);
+        pushVertex(mesh, p10, w, 0, textureIndex, light, ao10);
+        pushVertex(mesh, p01, 0, h, textureIndex, light, ao01);
+        pushVertex(mesh, p11, w, h, textureIndex, light, ao11);
+    }
+}
+
+bool isFaceVisible(const SectionSnapshot& snapshot, const Vec3i& pos, const BlockFace face) {
+    return !Blocks::isOpaque(snapshot.getBlock(pos.offset(face)));
+}
+
+void buildNaiveMesh(vector<uint32_t>& mesh, const SectionSnapshot& snapshot, const AtlasLayout& atlasLayout) {
+    for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+        for (int32_t y = 0; y < SECTION_HEIGHT; y++) {
+            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+                Vec3i blockPos(x, y, z);
+                const block_id bid = snapshot.getBlock(blockPos);
+                if (Blocks::isAir(bid))
+                    continue;
+
+                const int32_t coords[3] = { x, y, z };
+                for (const FaceLayout &layout : FACE_LAYOUTS) {
+                    if (isFaceVisible(snapshot, blockPos, layout.face)) {
+                        const Vec3i front = blockPos.offset(layout.face);
+                        const uint16_t textureIndex = atlasLayout.getBlockFaceTexture(bid, layout.face);
+                        emitFace(mesh, layout, coords[layout.normalAxis], coords[layout.uAxis], coords[layout.vAxis],
+                            1, 1, textureIndex, snapshot.getLight(front), computeFaceOcclusion(snapshot, layout, front));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void buildGreedyMesh(vector<uint32_t>& mesh, const SectionSnapshot& snapshot, const AtlasLayout& atlasLayout) {
+    // Visible faces in the current layer, indexed by [v][u], as the block id in the low 16 bits, the
+    // light in front of the face in the next 8 bits and the occlusion of its vertices in the high 8 bits.
+    // Faces merge only when all of them match. Air means no face.
+    std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> mask {};
+
+    for (const FaceLayout &layout : FACE_LAYOUTS) {
+        const int32_t uSize = SECTION_DIMENSIONS[layout.uAxis];
+        const int32_t vSize = SECTION_DIMENSIONS[layout.vAxis];
+
+        for (int32_t layer = 0; layer < SECTION_DIMENSIONS[layout.normalAxis]; layer++) {
+            // Gather the visible faces of this layer
+            for (int32_t v = 0; v < vSize; v++) {
+                for (int32_t u = 0; u < uSize; u++) {
+                    int32_t coords[3];
+                    coords[layout.normalAxis] = layer;
+                    coords[layout.uAxis] = u;
+                    coords[layout.vAxis] = v;
+                    const Vec3i blockPos(coords[0], coords[1], coords[2]);
+
+                    const block_id bid = snapshot.getBlock(blockPos);
+                    const bool visible = !Blocks::isAir(bid) && isFaceVisible(snapshot, blockPos, layout.face);
+                    if (!visible) {
+                        mask[v * uSize + u] = Blocks::AIR.id;
+                        continue;
+                    }
+                    const Vec3i front = blockPos.offset(layout.face);
+                    mask[v * uSize + u] = bid | static_cast<uint32_t>(snapshot.getLight(front)) << 16
+                        | static_cast<uint32_t>(computeFaceOcclusion(snapshot, layout, front)) << 24;
+                }
+            }
+
+            // Merge faces of the same block into rectangles, growing each one
+            // as far as possible along u, then along v.
+            for (int32_t v = 0; v < vSize; v++) {
+                for (int32_t u = 0; u < uSize;) {
+                    const uint32_t face = mask[v * uSize + u];
+                    if (face == Blocks::AIR.id) {
+                        u++;
+                        continue;
+                    }
+
+                    int32_t width = 1;
+                    while (u + width < uSize && mask[v * uSize + u + width] == face)
+                        width++;
+
+                    int32_t height = 1;
+                    while (v + height < vSize) {
+                        const uint32_t* row = &mask[(v + height) * uSize + u];
+                        bool rowMatches = true;
+                        for (int32_t i = 0; i < width; i++) {
+                            if (row[i] != face) {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!rowMatches)
+                            break;
+                        height++;
+                    }
+
+                    for (int32_t dv = 0; dv < height; dv++) {
+                        std::fill_n(&mask[(v + dv) * uSize + u], width, Blocks::AIR.id);
+                    }
+
+                    const auto bid = static_cast<block_id>(face & 0xFFFF);
+                    const uint16_t textureIndex = atlasLayout.getBlockFaceTexture(bid, layout.face);
+                    emitFace(mesh, layout, layer, u, v, width, height, textureIndex,
+                        static_cast<uint8_t>(face >> 16), static_cast<FaceOcclusion>(face >> 24));
+                    u += width;
+                }
+            }
+        }
+    }
+}
+
+void buildBinaryMesh(vector<uint32_t>& mesh, const SectionSnapshot& snapshot, const AtlasLayout& atlasLayout) {
+    // Opaque blocks of every snapshot column, and blocks that are not air in the section's own columns
+    std::array<ColumnMask, PADDED_CHUNK_SIZE * PADDED_CHUNK_SIZE> opacity {};
+    std::array<ColumnMask, CHUNK_SIZE * CHUNK_SIZE> occupancy {};
+    for (int32_t x = -1; x <= CHUNK_SIZE; x++) {
+        for (int32_t z = -1; z <= CHUNK_SIZE; z++) {
+            const block_id* column = snapshot.column(x, z);
+            ColumnMask opaqueMask = 0;
+            ColumnMask occupiedMask = 0;
+            for (int32_t i = 0; i < PADDED_SECTION_HEIGHT; i++) {
+                opaqueMask |= static_cast<ColumnMask>(Blocks::isOpaque(column[i])) << i;
+                occupiedMask |= static_cast<ColumnMask>(!Blocks::isAir(column[i])) << i;
+            }
+            opacity[(x + 1) * PADDED_CHUNK_SIZE + z + 1] = opaqueMask;
+            if (x >= 0 && x < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE)
+                occupancy[x * CHUNK_SIZE + z] = occupiedMask;
+        }
+    }
+    const auto opacityAt = [&opacity](const int32_t x, const int32_t z) {
+        return opacity[(x + 1) * PADDED_CHUNK_SIZE + z + 1];
+    };
+
+    // Visible faces of each column for every face layout, bit y being set when the face
+    // of the block at y is visible
+    std::array<std::array<ColumnMask, CHUNK_SIZE * CHUNK_SIZE>, FACE_LAYOUTS.size()> visibleFaces {};
+    size_t faceCount = 0;
+    for (size_t f = 0; f < FACE_LAYOUTS.size(); f++) {
+        const FaceLayout &layout = FACE_LAYOUTS[f];
+        const int32_t dx = layout.normalAxis == 0 ? (layout.positive ? 1 : -1) : 0;
+        const int32_t dz = layout.normalAxis == 2 ? (layout.positive ? 1 : -1) : 0;
+
+        for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+                const ColumnMask occupied = occupancy[x * CHUNK_SIZE + z] >> 1;
+                ColumnMask covered;
+                if (layout.normalAxis == 1)
+                    covered = layout.positive ? opacityAt(x, z) >> 2 : opacityAt(x, z);
+                else
+                    covered = opacityAt(x + dx, z + dz) >> 1;
+
+                const ColumnMask visible = occupied & ~covered & ((1u << SECTION_HEIGHT) - 1);
+                visibleFaces[f][x * CHUNK_SIZE + z] = visible;
+                faceCount += std::popcount(visible);
+            }
+        }
+    }
+
+    mesh.reserve(faceCount * 4 * CHUNK_VERTEX_WORDS);
+    for (size_t f = 0; f < FACE_LAYOUTS.size(); f++) {
+        const FaceLayout &layout = FACE_LAYOUTS[f];
+        const int32_t normalStep = layout.positive ? 1 : -1;
+        const int32_t dx = layout.normalAxis == 0 ? normalStep : 0;
+        const int32_t dy = layout.normalAxis == 1 ? normalStep : 0;
+        const int32_t dz = layout.normalAxis == 2 ? normalStep : 0;
+        for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+            for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+                ColumnMask visible = visibleFaces[f][x * CHUNK_SIZE + z];
+                if (visible == 0)
+                    continue;
+
+                const block_id* column = snapshot.column(x, z);
+                // Light of the blocks in front of the faces
+                const uint8_t* lightColumn = snapshot.lightColumn(x + dx, z + dz) + 1 + dy;
+                // Opacity of the blocks around the ones in front of the faces, indexed by [du + 1][dv + 1]
+                // and shifted so that bit y matches the face of the block at y
+                ColumnMask around[3][3];
+                for (int32_t du = -1; du <= 1; du++) {
+                    for (int32_t dv = -1; dv <= 1; dv++) {
+                        const Vec3i pos = offsetAlongFace(layout, Vec3i(x + dx, dy, z + dz), du, dv);
+                        around[du + 1][dv + 1] = opacityAt(pos.x, pos.z) >> (pos.y + 1);
+                    }
+                }
+                for (; visible != 0; visible &= visible - 1) {
+                    const int32_t y = std::countr_zero(visible);
+                    const uint16_t textureIndex = atlasLayout.getBlockFaceTexture(column[y + 1], layout.face);
+                    const int32_t coords[3] = { x, y, z };
+                    const FaceOcclusion occlusion = computeFaceOcclusion([&around, y](const int32_t du, const int32_t dv) {
+                        return (around[du + 1][dv + 1] >> y & 1) != 0;
+                    });
+                    emitFace(mesh, layout, coords[layout.normalAxis], coords[layout.uAxis], coords[layout.vAxis],
+                        1, 1, textureIndex, lightColumn[y], occlusion);
+                }
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> ChunkMesher::buildMesh(const SectionSnapshot& snapshot, const AtlasLayout& atlasLayout, const MeshingMode meshingMode) {
+    vector<uint32_t> mesh;
+    switch (meshingMode) {
+        case MeshingMode::NAIVE:
+            buildNaiveMesh(mesh, snapshot, atlasLayout);
+            break;
+        case MeshingMode::GREEDY:
+            buildGreedyMesh(mesh, snapshot, atlasLayout);
+            break;
+        case MeshingMode::BINARY:
+            buildBinaryMesh(mesh, snapshot, atlasLayout);
+            break;
+    }
+    return mesh;
+}
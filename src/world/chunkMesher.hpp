@@ -0,0 +1,31 @@
+#ifndef VOXELS_CHUNKMESHER_HPP
+#define VOXELS_CHUNKMESHER_HPP
+
+#include <vector>
+
+#include "world/sectionSnapshot.hpp"
+#include "texturemanip/atlasLayout.hpp"
+
+/*
+ * Chunk meshes are made of quads of 4 vertices, drawn with a QuadIndexBuffer.
+ * Vertices are packed into two 32-bit words, decoded in chunk.vert:
+ * - word 0: x (bits 0-5), y (bits 6-12), z (bits 13-18), relative to the section origin, light of the block
+ *   in front of the face (bits 19-26, see SectionLight), ambient occlusion of the vertex from 0 (fully
+ *   occluded) to 3 (bits 27-28)
+ * - word 1: u (bits 0-6), v (bits 7-13) texture coordinates in tiles, atlas texture index (bits 16-31)
+ */
+#define CHUNK_VERTEX_WORDS 2
+
+enum class MeshingMode {
+    NAIVE, // One quad per visible block face
+    GREEDY, // Coplanar faces of the same block merged into maximal rectangles
+    BINARY // One quad per visible block face, found with bitwise operations on column occupancy masks
+};
+
+namespace ChunkMesher {
+    // Builds the mesh of the section in the snapshot.
+    // Safe to call from any thread, as long as no texture is registered in the atlas meanwhile.
+    [[nodiscard]] std::vector<uint32_t> buildMesh(const SectionSnapshot& snapshot, const AtlasLayout& atlasLayout, MeshingMode meshingMode);
+}
+
+#endif //VOXELS_CHUNKMESHER_HPP
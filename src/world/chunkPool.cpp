@@ -0,0 +1,26 @@
+#include "world/chunkPool.hpp"
+
+#define CHUNK_POOL_SLAB_SIZE 64
+
+Chunk* ChunkPool::acquire(const Vec3i chunkCoordinate) {
+    if (!freeChunks.empty()) {
+        Chunk* chunk = freeChunks.back();
+        freeChunks.pop_back();
+        chunk->reset(chunkCoordinate);
+        return chunk;
+    }
+
+    if (slabs.empty() || slabs.back().size() == CHUNK_POOL_SLAB_SIZE) {
+        slabs.emplace_back();
+        slabs.back().reserve(CHUNK_POOL_SLAB_SIZE);
+    }
+    return &slabs.back().emplace_back(chunkCoordinate);
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    freeChunks.push_back(chunk);
+}
+
+size_t ChunkPool::capacity() const {
+    return slabs.empty() ? 0 : (slabs.size() - 1) * CHUNK_POOL_SLAB_SIZE + slabs.back().size();
+}
@@ -0,0 +1,29 @@
+#ifndef VOXELS_CHUNKPOOL_HPP
+#define VOXELS_CHUNKPOOL_HPP
+
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/chunk.hpp"
+
+/**
+ * Allocates chunks in slabs of CHUNK_POOL_SLAB_SIZE and recycles released ones, keeping the memory of
+ * their sections. Chunks never move, and once as many chunks as the peak number loaded at once have been
+ * allocated, acquiring and releasing chunks allocates nothing.
+ */
+class ChunkPool {
+    // Each slab is reserved up front and never grows past it, so its chunks keep their address
+    std::vector<std::vector<Chunk>> slabs;
+    std::vector<Chunk*> freeChunks;
+
+public:
+    // An empty chunk at the coordinate, reused from a released chunk when possible.
+    [[nodiscard]] Chunk* acquire(Vec3i chunkCoordinate);
+    // Returns the chunk to the pool, it must not be used anymore.
+    void release(Chunk* chunk);
+
+    // Number of chunks allocated by the pool, in use or free.
+    [[nodiscard]] size_t capacity() const;
+};
+
+#endif //VOXELS_CHUNKPOOL_HPP
@@ -0,0 +1,175 @@
+#include "world/chunkSaveWorker.hpp"
+
+#include <utility>
+
+#include "logger.hpp"
+
+// Reads queued at once, so newly needed nearby chunks do not wait behind far away ones
+#define MAX_PENDING_CHUNK_LOADS 64
+
+ChunkSaveWorker::ChunkSaveWorker(std::unique_ptr<RegionStorage> storage): storage(std::move(storage)) {
+    worker = std::thread(&ChunkSaveWorker::work, this);
+}
+
+ChunkSaveWorker::~ChunkSaveWorker() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_one();
+    worker.join();
+}
+
+void ChunkSaveWorker::save(const Chunk &chunk) {
+    const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+    {
+        std::lock_guard lock(mutex);
+        const auto it = pendingSaves.find(chunkCoordinate);
+        if (it != pendingSaves.end()) {
+            // Still waiting, updated in place. Being written, replaced and queued again once done.
+            if (it->second.use_count() > 1)
+                it->second = newChunk(chunkCoordinate);
+            it->second->copyBlocksFrom(chunk);
+            return;
+        }
+        std::shared_ptr<Chunk> saved = newChunk(chunkCoordinate);
+        saved->copyBlocksFrom(chunk);
+        pendingSaves.emplace(chunkCoordinate, std::move(saved));
+        saveOrder.push_back(chunkCoordinate);
+    }
+    workAvailable.notify_one();
+}
+
+void ChunkSaveWorker::collectLoads() {
+    std::vector<LoadResult> finished;
+    {
+        std::lock_guard lock(mutex);
+        finished = std::exchange(loadResults, {});
+    }
+
+    for (LoadResult &result : finished) {
+        pendingLoads--;
+        const auto it = loads.find(result.chunkCoordinate);
+        // Discarded while it was being read
+        if (it == loads.end() || it->second.done) {
+            if (result.chunk) {
+                std::lock_guard lock(mutex);
+                freeChunks.push_back(std::move(result.chunk));
+            }
+            continue;
+        }
+        it->second.done = true;
+        it->second.chunk = std::move(result.chunk);
+    }
+}
+
+ChunkLoadStatus ChunkSaveWorker::load(const Vec3i chunkCoordinate) {
+    const auto it = loads.find(chunkCoordinate);
+    if (it == loads.end()) {
+        if (pendingLoads == MAX_PENDING_CHUNK_LOADS)
+            return ChunkLoadStatus::PENDING;
+        loads.emplace(chunkCoordinate, ChunkLoad {});
+        {
+            std::lock_guard lock(mutex);
+            loadOrder.push_back(chunkCoordinate);
+        }
+        workAvailable.notify_one();
+        pendingLoads++;
+        return ChunkLoadStatus::PENDING;
+    }
+
+    if (!it->second.done)
+        return ChunkLoadStatus::PENDING;
+    if (it->second.chunk)
+        return ChunkLoadStatus::LOADED;
+    loads.erase(it);
+    return ChunkLoadStatus::NOT_SAVED;
+}
+
+void ChunkSaveWorker::take(const Vec3i chunkCoordinate, Chunk &chunk) {
+    const auto it = loads.find(chunkCoordinate);
+    if (it == loads.end() || !it->second.chunk)
+        Logger::crash("Trying to take a chunk that is not loaded");
+    // The empty chunk's memory is reused by the next read
+    std::swap(chunk, *it->second.chunk);
+    {
+        std::lock_guard lock(mutex);
+        freeChunks.push_back(std::move(it->second.chunk));
+    }
+    loads.erase(it);
+}
+
+void ChunkSaveWorker::discard(const std::function<bool(Vec3i)> &far) {
+    std::lock_guard lock(mutex);
+    for (auto it = loads.begin(); it != loads.end();) {
+        if (!far(it->first)) {
+            ++it;
+            continue;
+        }
+        if (it->second.chunk)
+            freeChunks.push_back(std::move(it->second.chunk));
+        it = loads.erase(it);
+    }
+}
+
+std::shared_ptr<Chunk> ChunkSaveWorker::newChunk(const Vec3i chunkCoordinate) {
+    if (freeChunks.empty())
+        return std::make_shared<Chunk>(chunkCoordinate);
+    std::shared_ptr<Chunk> chunk = std::move(freeChunks.back());
+    freeChunks.pop_back();
+    chunk->reset(chunkCoordinate);
+    return chunk;
+}
+
+std::shared_ptr<Chunk> ChunkSaveWorker::read(const Vec3i chunkCoordinate, std::unique_lock<std::mutex> &lock) {
+    std::shared_ptr<Chunk> chunk = newChunk(chunkCoordinate);
+    if (const auto it = pendingSaves.find(chunkCoordinate); it != pendingSaves.end()) {
+        chunk->copyBlocksFrom(*it->second);
+        return chunk;
+    }
+
+    // A chunk no longer pending has been fully written, and only this thread writes
+    lock.unlock();
+    const bool saved = storage->loadChunk(*chunk);
+    lock.lock();
+    if (!saved) {
+        freeChunks.push_back(std::move(chunk));
+        return nullptr;
+    }
+    return chunk;
+}
+
+void ChunkSaveWorker::work() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this] { return stopping || !saveOrder.empty() || !loadOrder.empty(); });
+
+        // Reads are waited for by the world, writes are not. Reads are dropped once stopping.
+        if (!stopping && !loadOrder.empty()) {
+            const Vec3i chunkCoordinate = loadOrder.front();
+            loadOrder.pop_front();
+            std::shared_ptr<Chunk> chunk = read(chunkCoordinate, lock);
+            loadResults.push_back({ chunkCoordinate, std::move(chunk) });
+            continue;
+        }
+        if (saveOrder.empty())
+            return;
+
+        const Vec3i chunkCoordinate = saveOrder.front();
+        saveOrder.pop_front();
+        std::shared_ptr<Chunk> chunk = pendingSaves.at(chunkCoordinate);
+        lock.unlock();
+
+        storage->saveChunk(*chunk);
+
+        lock.lock();
+        const auto it = pendingSaves.find(chunkCoordinate);
+        if (it->second == chunk) {
+            pendingSaves.erase(it);
+        } else {
+            saveOrder.push_back(chunkCoordinate);
+        }
+        // Only held here now, whether it was written last or replaced while being written
+        freeChunks.push_back(std::move(chunk));
+    }
+}
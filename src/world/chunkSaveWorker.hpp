@@ -0,0 +1,82 @@
+#ifndef VOXELS_CHUNKSAVEWORKER_HPP
+#define VOXELS_CHUNKSAVEWORKER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "world/chunk.hpp"
+#include "world/regionStorage.hpp"
+
+enum class ChunkLoadStatus {
+    PENDING, // Being read, or waiting for earlier reads
+    LOADED, // Read, ready to be taken
+    NOT_SAVED, // Never saved, or its saved data is invalid
+};
+
+/**
+ * Thread reading and writing chunks in region storage in the background, so disk access never stalls the
+ * render thread. Chunks to write are copied into chunks of the worker. Reads are requested and their results
+ * taken like GenerationPipeline's, and see the chunks still waiting to be written. Read, taken and written
+ * chunks' memory is reused. Reads go before writes. Remaining chunks are written before the worker is destroyed.
+ */
+class ChunkSaveWorker {
+    struct LoadResult {
+        Vec3i chunkCoordinate;
+        std::shared_ptr<Chunk> chunk; // nullptr when the chunk was never saved
+    };
+
+    // Reads requested from the calling thread, nullptr until done or when the chunk was never saved
+    struct ChunkLoad {
+        bool done = false;
+        std::shared_ptr<Chunk> chunk;
+    };
+
+    std::unique_ptr<RegionStorage> storage; // Only used by the worker thread
+    unordered_map<Vec3i, ChunkLoad> loads;
+    int32_t pendingLoads = 0;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::deque<Vec3i> saveOrder;
+    // Latest version of each chunk waiting to be written, kept until it is written
+    unordered_map<Vec3i, std::shared_ptr<Chunk>> pendingSaves;
+    std::vector<std::shared_ptr<Chunk>> freeChunks; // Memory of taken and written chunks, reused by the next ones
+    std::deque<Vec3i> loadOrder;
+    std::vector<LoadResult> loadResults;
+    bool stopping = false;
+
+    void work();
+    // Takes a chunk from freeChunks, or allocates one when it is empty. Called with the mutex held.
+    [[nodiscard]] std::shared_ptr<Chunk> newChunk(Vec3i chunkCoordinate);
+    // Reads the chunk from the latest queued version or from storage, on the worker thread
+    [[nodiscard]] std::shared_ptr<Chunk> read(Vec3i chunkCoordinate, std::unique_lock<std::mutex> &lock);
+
+public:
+    explicit ChunkSaveWorker(std::unique_ptr<RegionStorage> storage);
+    ~ChunkSaveWorker();
+
+    ChunkSaveWorker(const ChunkSaveWorker&) = delete;
+    ChunkSaveWorker& operator=(const ChunkSaveWorker&) = delete;
+
+    // Queues a copy of the chunk's blocks for writing, replacing an older version of it still waiting.
+    void save(const Chunk &chunk);
+
+    // Stores the reads finished since the last call. Called before loading chunks.
+    void collectLoads();
+    // Queues a read of the chunk's latest saved or queued blocks unless one is queued or done already, nearest
+    // chunks first when called in order of distance. NOT_SAVED is only returned once per read.
+    ChunkLoadStatus load(Vec3i chunkCoordinate);
+    // Swaps the LOADED chunk into chunk, which must be empty.
+    void take(Vec3i chunkCoordinate, Chunk &chunk);
+    // Forgets the reads of the chunks far is true for, reading them again if they are needed later.
+    void discard(const std::function<bool(Vec3i)> &far);
+};
+
+#endif //VOXELS_CHUNKSAVEWORKER_HPP
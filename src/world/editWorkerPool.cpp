@@ -0,0 +1,74 @@
+#include "world/editWorkerPool.hpp"
+
+EditWorkerPool::EditWorkerPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&EditWorkerPool::work, this);
+    }
+}
+
+EditWorkerPool::~EditWorkerPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void EditWorkerPool::runTasks(const size_t taskCount, const std::function<void(size_t)> &task) {
+    if (workers.empty()) {
+        for (size_t i = 0; i < taskCount; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        this->task = &task;
+        this->taskCount = taskCount;
+        nextTask = 0;
+        busyWorkers = workers.size();
+        run++;
+    }
+    workAvailable.notify_all();
+
+    runQueuedTasks();
+
+    // Workers still read task and taskCount until they are done with the run
+    std::unique_lock lock(mutex);
+    workDone.wait(lock, [this] { return busyWorkers == 0; });
+    this->task = nullptr;
+}
+
+void EditWorkerPool::runQueuedTasks() {
+    for (size_t i = nextTask++; i < taskCount; i = nextTask++) {
+        (*task)(i);
+    }
+}
+
+void EditWorkerPool::work() {
+    uint64_t lastRun = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this, lastRun] { return stopping || run != lastRun; });
+        if (stopping)
+            return;
+        lastRun = run;
+        lock.unlock();
+
+        runQueuedTasks();
+
+        lock.lock();
+        if (--busyWorkers == 0)
+            workDone.notify_one();
+    }
+}
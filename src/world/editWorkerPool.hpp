@@ -0,0 +1,44 @@
+#ifndef VOXELS_EDITWORKERPOOL_HPP
+#define VOXELS_EDITWORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Threads kept waiting for bulk edits, so edits spread over several chunks do not start threads each time.
+ * The calling thread runs tasks too and returns once all of them have run.
+ */
+class EditWorkerPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    const std::function<void(size_t)>* task = nullptr;
+    size_t taskCount = 0;
+    std::atomic<size_t> nextTask = 0;
+    uint64_t run = 0; // Incremented per call to runTasks, so each worker joins each run once
+    size_t busyWorkers = 0;
+    bool stopping = false;
+
+    void work();
+    void runQueuedTasks();
+
+public:
+    // Uses one thread per core besides the calling thread when threadCount is 0, none on a single core.
+    explicit EditWorkerPool(unsigned int threadCount = 0);
+    ~EditWorkerPool();
+
+    EditWorkerPool(const EditWorkerPool&) = delete;
+    EditWorkerPool& operator=(const EditWorkerPool&) = delete;
+
+    // Calls task with every index below taskCount, spread over the workers and the calling thread. Not
+    // reentrant, runs from several threads at once are not supported.
+    void runTasks(size_t taskCount, const std::function<void(size_t)> &task);
+};
+
+#endif //VOXELS_EDITWORKERPOOL_HPP
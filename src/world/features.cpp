@@ -0,0 +1,65 @@
+#include "world/features.hpp"
+
+#include <cstdlib>
+
+#include "world/blocks.hpp"
+#include "world/chunk.hpp"
+
+// Which block is kept where features overlap each other or the terrain: air gives way to everything,
+// leaves to logs, and the other blocks to nothing
+uint8_t getPlacementPriority(const block_id id) {
+    static constexpr auto priorities = Blocks::makePropertyTable<uint8_t>([](const Block& block) -> uint8_t {
+        if (block.id == Blocks::AIR.id)
+            return 0;
+        if (block.id == Blocks::LEAVES.id)
+            return 1;
+        if (block.id == Blocks::LOG.id)
+            return 2;
+        return 3;
+    });
+    return priorities[id];
+}
+
+void Features::placeTree(std::vector<FeatureBlock> &blocks, const Vec3i base, const int32_t height) {
+    for (int32_t y = 0; y < height; y++) {
+        blocks.push_back({ { base.x, base.y + y, base.z }, Blocks::LOG.id });
+    }
+
+    // Two wide layers without their corners, then two narrow ones, the top one without its corners
+    for (int32_t y = height - 3; y <= height; y++) {
+        const int32_t radius = y < height - 1 ? 2 : 1;
+        const bool cutCorners = y != height - 1;
+        for (int32_t x = -radius; x <= radius; x++) {
+            for (int32_t z = -radius; z <= radius; z++) {
+                if (cutCorners && std::abs(x) == radius && std::abs(z) == radius)
+                    continue;
+                blocks.push_back({ { base.x + x, base.y + y, base.z + z }, Blocks::LEAVES.id });
+            }
+        }
+    }
+}
+
+void Features::placeBoulder(std::vector<FeatureBlock> &blocks, const Vec3i center, const int32_t radius) {
+    const int32_t limit = radius * radius + radius;
+    for (int32_t x = -radius; x <= radius; x++) {
+        for (int32_t y = -radius; y <= radius; y++) {
+            for (int32_t z = -radius; z <= radius; z++) {
+                if (x * x + y * y + z * z <= limit)
+                    blocks.push_back({ { center.x + x, center.y + y, center.z + z }, Blocks::STONE.id });
+            }
+        }
+    }
+}
+
+void Features::apply(Chunk &chunk, const std::span<const FeatureBlock> blocks) {
+    const Vec3i origin = chunk.getOrigin();
+    for (const auto &[pos, id] : blocks) {
+        const Vec3i chunkPos(pos.x - origin.x, pos.y - origin.y, pos.z - origin.z);
+        if (chunkPos.x < 0 || chunkPos.x >= CHUNK_SIZE
+                || chunkPos.y < 0 || chunkPos.y >= CHUNK_HEIGHT
+                || chunkPos.z < 0 || chunkPos.z >= CHUNK_SIZE)
+            continue;
+        if (getPlacementPriority(id) > getPlacementPriority(chunk.getBlockUnchecked(chunkPos.x, chunkPos.y, chunkPos.z)))
+            chunk.setBlock(chunkPos, id);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef VOXELS_FEATURES_HPP
+#define VOXELS_FEATURES_HPP
+
+#include <span>
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/block.hpp"
+
+class Chunk;
+
+// Chunks around the chunk a feature is rooted in that it may place blocks in, on every axis
+#define FEATURE_REACH_CHUNKS 1
+
+// Block placed by a decoration feature, at a world position.
+struct FeatureBlock {
+    Vec3i pos;
+    block_id id;
+};
+
+/**
+ * Decoration features placed on generated terrain, like trees and boulders. The features rooted in a chunk
+ * are chosen from the chunk's terrain alone and may place blocks up to FEATURE_REACH_CHUNKS chunks away.
+ *
+ * Features never replace terrain, and where they overlap the block with the highest placement priority wins,
+ * so a chunk ends up with the same blocks whatever order the features around it are applied in.
+ */
+namespace Features {
+    // Trunk of height logs starting at base, under a canopy of leaves.
+    void placeTree(std::vector<FeatureBlock> &blocks, Vec3i base, int32_t height);
+    // Stone ball like WorldEdit::fillSphere.
+    void placeBoulder(std::vector<FeatureBlock> &blocks, Vec3i center, int32_t radius);
+
+    // Places the blocks that fall within the chunk.
+    void apply(Chunk &chunk, std::span<const FeatureBlock> blocks);
+}
+
+#endif //VOXELS_FEATURES_HPP
@@ -0,0 +1,207 @@
+#include "world/generationPipeline.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+#include "logger.hpp"
+
+// Jobs queued or running at once, so newly requested nearby chunks do not wait behind far away ones
+#define MAX_PENDING_GENERATION_JOBS 32
+
+GenerationPipeline::GenerationPipeline(const TerrainGenerator &generator, unsigned int threadCount):
+    generator(generator) {
+    if (threadCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&GenerationPipeline::work, this);
+    }
+}
+
+GenerationPipeline::~GenerationPipeline() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+bool GenerationPipeline::schedule(const Vec3i chunkCoordinate, ProtoChunk &protoChunk) {
+    if (protoChunk.generating || protoChunk.generated)
+        return true;
+    if (pendingJobs == MAX_PENDING_GENERATION_JOBS)
+        return false;
+
+    std::unique_ptr<Chunk> chunk;
+    if (freeChunks.empty()) {
+        chunk = std::make_unique<Chunk>(chunkCoordinate);
+    } else {
+        chunk = std::move(freeChunks.back());
+        freeChunks.pop_back();
+    }
+    submit({ chunkCoordinate, std::move(chunk), {}, nullptr });
+    protoChunk.generating = true;
+    return true;
+}
+
+void GenerationPipeline::submit(GenerationJob job) {
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+    pendingJobs++;
+}
+
+void GenerationPipeline::collectResults() {
+    std::vector<GenerationJob> finished;
+    {
+        std::lock_guard lock(mutex);
+        finished = std::exchange(results, {});
+    }
+
+    for (GenerationJob &job : finished) {
+        pendingJobs--;
+        if (job.skyHeights) {
+            const auto it = skyHeights.find({job.chunkCoordinate.x, job.chunkCoordinate.z});
+            // Discarded while they were being computed
+            if (it != skyHeights.end() && !it->second)
+                it->second = std::move(job.skyHeights);
+            continue;
+        }
+
+        const auto it = protoChunks.find(job.chunkCoordinate);
+        // Discarded while it was being generated
+        if (it == protoChunks.end() || !it->second.generating) {
+            freeChunks.push_back(std::move(job.chunk));
+            continue;
+        }
+
+        const Vec3i root = job.chunkCoordinate;
+        for (const FeatureBlock &block : job.features) {
+            const Vec3i target = blockPosToChunkPos(block.pos);
+            if (std::abs(target.x - root.x) > FEATURE_REACH_CHUNKS || std::abs(target.y - root.y) > FEATURE_REACH_CHUNKS
+                    || std::abs(target.z - root.z) > FEATURE_REACH_CHUNKS)
+                Logger::crash("Feature placed a block further than FEATURE_REACH_CHUNKS from its chunk");
+        }
+
+        ProtoChunk &protoChunk = it->second;
+        protoChunk.generating = false;
+        protoChunk.generated = true;
+        protoChunk.features = std::move(job.features);
+        // Chunks only generated for their features do not keep their terrain
+        if (protoChunk.requested)
+            protoChunk.terrain = std::move(job.chunk);
+        else
+            freeChunks.push_back(std::move(job.chunk));
+    }
+}
+
+bool GenerationPipeline::request(const Vec3i chunkCoordinate) {
+    ProtoChunk &protoChunk = protoChunks[chunkCoordinate];
+    protoChunk.requested = true;
+    // Generated for its features only, or taken then unloaded
+    if (protoChunk.generated && !protoChunk.terrain)
+        protoChunk.generated = false;
+    if (!schedule(chunkCoordinate, protoChunk))
+        return false;
+
+    bool complete = protoChunk.generated;
+    for (int32_t x = -FEATURE_REACH_CHUNKS; x <= FEATURE_REACH_CHUNKS; x++) {
+        for (int32_t y = -FEATURE_REACH_CHUNKS; y <= FEATURE_REACH_CHUNKS; y++) {
+            for (int32_t z = -FEATURE_REACH_CHUNKS; z <= FEATURE_REACH_CHUNKS; z++) {
+                const Vec3i neighborCoordinate(chunkCoordinate.x + x, chunkCoordinate.y + y, chunkCoordinate.z + z);
+                ProtoChunk &neighbor = protoChunks[neighborCoordinate];
+                if (!schedule(neighborCoordinate, neighbor))
+                    return false;
+                complete = complete && neighbor.generated;
+            }
+        }
+    }
+    return complete;
+}
+
+bool GenerationPipeline::isRequested(const Vec3i chunkCoordinate) const {
+    const auto it = protoChunks.find(chunkCoordinate);
+    return it != protoChunks.end() && it->second.requested;
+}
+
+void GenerationPipeline::take(const Vec3i chunkCoordinate, Chunk &chunk) {
+    const auto it = protoChunks.find(chunkCoordinate);
+    if (it == protoChunks.end() || !it->second.terrain)
+        Logger::crash("Trying to take a chunk that is not generated");
+    ProtoChunk &protoChunk = it->second;
+
+    // The empty chunk's memory is reused by the next job
+    std::swap(chunk, *protoChunk.terrain);
+    freeChunks.push_back(std::move(protoChunk.terrain));
+    protoChunk.requested = false;
+
+    for (int32_t x = -FEATURE_REACH_CHUNKS; x <= FEATURE_REACH_CHUNKS; x++) {
+        for (int32_t y = -FEATURE_REACH_CHUNKS; y <= FEATURE_REACH_CHUNKS; y++) {
+            for (int32_t z = -FEATURE_REACH_CHUNKS; z <= FEATURE_REACH_CHUNKS; z++) {
+                const Vec3i neighborCoordinate(chunkCoordinate.x + x, chunkCoordinate.y + y, chunkCoordinate.z + z);
+                Features::apply(chunk, protoChunks.at(neighborCoordinate).features);
+            }
+        }
+    }
+}
+
+void GenerationPipeline::discard(const std::function<bool(Vec3i)> &far) {
+    for (auto it = protoChunks.begin(); it != protoChunks.end();) {
+        if (!far(it->first)) {
+            ++it;
+            continue;
+        }
+        if (it->second.terrain)
+            freeChunks.push_back(std::move(it->second.terrain));
+        it = protoChunks.erase(it);
+    }
+}
+
+const HeightMap* GenerationPipeline::requestSkyHeights(const Vec2i chunkColumn) {
+    const auto it = skyHeights.find(chunkColumn);
+    if (it != skyHeights.end())
+        return it->second.get();
+    if (pendingJobs == MAX_PENDING_GENERATION_JOBS)
+        return nullptr;
+
+    skyHeights.emplace(chunkColumn, nullptr);
+    submit({ {chunkColumn.x, 0, chunkColumn.y}, nullptr, {}, std::make_unique<HeightMap>() });
+    return nullptr;
+}
+
+void GenerationPipeline::discardSkyHeights(const std::function<bool(Vec2i)> &far) {
+    std::erase_if(skyHeights, [&far](const auto &entry) { return far(entry.first); });
+}
+
+void GenerationPipeline::work() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping)
+            return;
+
+        GenerationJob job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+
+        // Both stages only read and write the job's chunk, so any number of jobs run at once
+        if (job.skyHeights) {
+            *job.skyHeights = generator.getSkyHeights({job.chunkCoordinate.x, job.chunkCoordinate.z});
+        } else {
+            job.chunk->reset(job.chunkCoordinate);
+            generator.generate(*job.chunk, job.chunkCoordinate);
+            generator.placeFeatures(*job.chunk, job.chunkCoordinate, job.features);
+        }
+
+        lock.lock();
+        results.push_back(std::move(job));
+    }
+}
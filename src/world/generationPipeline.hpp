@@ -0,0 +1,92 @@
+#ifndef VOXELS_GENERATIONPIPELINE_HPP
+#define VOXELS_GENERATIONPIPELINE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "world/chunk.hpp"
+#include "world/features.hpp"
+#include "world/terrainGenerator.hpp"
+
+/**
+ * Generates chunks in stages on a pool of threads: the terrain of a chunk first, then the features rooted
+ * in it, from its terrain alone. A chunk is complete once its terrain and the features of every chunk
+ * within FEATURE_REACH_CHUNKS of it are known, the features then being applied to it. Chunks around the
+ * requested ones are generated for their features only.
+ *
+ * The blocks placed by features are kept by the chunk they are rooted in until the chunks they reach are
+ * complete, and features never depend on each other, so the blocks of a chunk do not depend on the order
+ * the stages ran in.
+ *
+ * The pool also computes the sky heights of chunk columns, see TerrainGenerator::getSkyHeights.
+ */
+class GenerationPipeline {
+    struct GenerationJob {
+        Vec3i chunkCoordinate; // Of any chunk of the column for sky height jobs
+        std::unique_ptr<Chunk> chunk; // nullptr for sky height jobs
+        std::vector<FeatureBlock> features;
+        std::unique_ptr<HeightMap> skyHeights; // Computed instead of the chunk's stages when set
+    };
+
+    // Generation state of a chunk, kept while chunks around it may need its features
+    struct ProtoChunk {
+        std::unique_ptr<Chunk> terrain; // Generated blocks, until the chunk is taken
+        std::vector<FeatureBlock> features; // Blocks placed by the features rooted in the chunk
+        bool generating = false;
+        bool generated = false;
+        bool requested = false; // Whether the chunk itself is wanted, not only its features
+    };
+
+    const TerrainGenerator &generator;
+    unordered_map<Vec3i, ProtoChunk> protoChunks;
+    unordered_map<Vec2i, std::unique_ptr<HeightMap>> skyHeights; // Of chunk columns, nullptr while computed
+    std::vector<std::unique_ptr<Chunk>> freeChunks; // Taken chunks' memory, reused by the next jobs
+    int32_t pendingJobs = 0;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::deque<GenerationJob> jobs;
+    std::vector<GenerationJob> results;
+    bool stopping = false;
+
+    void work();
+    // Submits a job for the chunk unless it is generated or being generated. Returns false when too many
+    // jobs are pending already.
+    bool schedule(Vec3i chunkCoordinate, ProtoChunk &protoChunk);
+    void submit(GenerationJob job);
+
+public:
+    // Uses one thread per core, leaving one for the render thread, when threadCount is 0.
+    explicit GenerationPipeline(const TerrainGenerator &generator, unsigned int threadCount = 0);
+    ~GenerationPipeline();
+
+    GenerationPipeline(const GenerationPipeline&) = delete;
+    GenerationPipeline& operator=(const GenerationPipeline&) = delete;
+
+    // Stores the stages finished since the last call. Called before requesting chunks.
+    void collectResults();
+    // Schedules the stages the chunk is waiting for, nearest ones first when called in order of distance.
+    // Returns whether the chunk is complete.
+    bool request(Vec3i chunkCoordinate);
+    // Whether the chunk was requested and is not taken yet.
+    [[nodiscard]] bool isRequested(Vec3i chunkCoordinate) const;
+    // Swaps the complete chunk into chunk, which must be empty.
+    void take(Vec3i chunkCoordinate, Chunk &chunk);
+    // Forgets the chunks far is true for, generating them again if they are needed later.
+    void discard(const std::function<bool(Vec3i)> &far);
+
+    // Schedules the sky heights of the chunk column at x, z unless they are known or being computed, like
+    // request. Returns them once known, nullptr until then.
+    [[nodiscard]] const HeightMap* requestSkyHeights(Vec2i chunkColumn);
+    // Forgets the sky heights of the chunk columns far is true for.
+    void discardSkyHeights(const std::function<bool(Vec2i)> &far);
+};
+
+#endif //VOXELS_GENERATIONPIPELINE_HPP
@@ -0,0 +1,431 @@
+#include "world/lightEngine.hpp"
+
+#include <algorithm>
+
+#include "world/blocks.hpp"
+
+// Flag of light properties, the low bits holding the light emitted
+#define LIGHT_OPAQUE 0x80
+// Distance between the indices of adjacent blocks along x and z, y being contiguous
+#define X_STRIDE (CHUNK_SIZE * CHUNK_HEIGHT)
+#define Z_STRIDE CHUNK_HEIGHT
+
+struct LightNeighborSide {
+    BlockFace side;
+    BlockFace opposite;
+    int32_t dx;
+    int32_t dy;
+    int32_t dz;
+};
+
+constexpr LightNeighborSide LIGHT_NEIGHBOR_SIDES[] = {
+    { BlockFace::NORTH, BlockFace::SOUTH, 0, 0, -1 },
+    { BlockFace::SOUTH, BlockFace::NORTH, 0, 0, 1 },
+    { BlockFace::EAST, BlockFace::WEST, 1, 0, 0 },
+    { BlockFace::WEST, BlockFace::EAST, -1, 0, 0 },
+    { BlockFace::UP, BlockFace::DOWN, 0, 1, 0 },
+    { BlockFace::DOWN, BlockFace::UP, 0, -1, 0 },
+};
+
+constexpr BlockFace LIGHT_DIRECTIONS[] = {
+    BlockFace::DOWN, BlockFace::UP, BlockFace::NORTH, BlockFace::SOUTH, BlockFace::EAST, BlockFace::WEST
+};
+
+int32_t columnIndex(const int32_t x, const int32_t z) {
+    return x * X_STRIDE + z * Z_STRIDE;
+}
+
+// Number of blocks along the second coordinate of a chunk's layer of blocks on the given face
+int32_t faceLayerHeight(const BlockFace face) {
+    return face == BlockFace::UP || face == BlockFace::DOWN ? CHUNK_SIZE : CHUNK_HEIGHT;
+}
+
+// Index of a block of the chunk's layer of blocks on the given face, a going along x or z and b along z or y
+int32_t faceLayerIndex(const BlockFace face, const int32_t a, const int32_t b) {
+    switch (face) {
+        case BlockFace::DOWN: return columnIndex(a, b);
+        case BlockFace::UP: return columnIndex(a, b) + CHUNK_HEIGHT - 1;
+        case BlockFace::NORTH: return columnIndex(a, 0) + b;
+        case BlockFace::SOUTH: return columnIndex(a, CHUNK_SIZE - 1) + b;
+        case BlockFace::WEST: return columnIndex(0, a) + b;
+        case BlockFace::EAST: return columnIndex(CHUNK_SIZE - 1, a) + b;
+    }
+    return 0;
+}
+
+uint8_t getChannel(const uint8_t light, const bool sky) {
+    return sky ? getSkyLight(light) : getBlockLight(light);
+}
+
+uint8_t withChannel(const uint8_t light, const bool sky, const uint8_t level) {
+    return sky ? (light & BLOCK_LIGHT_MASK) | level << SKY_LIGHT_SHIFT : (light & ~BLOCK_LIGHT_MASK) | level;
+}
+
+uint8_t getLightProperties(const block_id id) {
+    static constexpr auto properties = Blocks::makePropertyTable<uint8_t>([](const Block& block) {
+        return static_cast<uint8_t>((block.opaque ? LIGHT_OPAQUE : 0) | block.lightEmission);
+    });
+    return properties[id];
+}
+
+// Moves chunk and index to the adjacent block in the given direction, returns false past the loaded chunks
+template<typename ChunkPointer>
+bool step(ChunkPointer &chunk, int32_t &index, const BlockFace direction) {
+    // Indices are never negative, unsigned division by the power of two strides is a shift
+    const auto unsignedIndex = static_cast<uint32_t>(index);
+    const uint32_t y = unsignedIndex % CHUNK_HEIGHT;
+    const uint32_t z = unsignedIndex / Z_STRIDE % CHUNK_SIZE;
+    const uint32_t x = unsignedIndex / X_STRIDE;
+    switch (direction) {
+        case BlockFace::DOWN:
+            if (y > 0) {
+                index--;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::DOWN)];
+            index += CHUNK_HEIGHT - 1;
+            return chunk != nullptr;
+        case BlockFace::UP:
+            if (y < CHUNK_HEIGHT - 1) {
+                index++;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::UP)];
+            index -= CHUNK_HEIGHT - 1;
+            return chunk != nullptr;
+        case BlockFace::NORTH:
+            if (z > 0) {
+                index -= Z_STRIDE;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::NORTH)];
+            index += (CHUNK_SIZE - 1) * Z_STRIDE;
+            return chunk != nullptr;
+        case BlockFace::SOUTH:
+            if (z < CHUNK_SIZE - 1) {
+                index += Z_STRIDE;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::SOUTH)];
+            index -= (CHUNK_SIZE - 1) * Z_STRIDE;
+            return chunk != nullptr;
+        case BlockFace::WEST:
+            if (x > 0) {
+                index -= X_STRIDE;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::WEST)];
+            index += (CHUNK_SIZE - 1) * X_STRIDE;
+            return chunk != nullptr;
+        case BlockFace::EAST:
+            if (x < CHUNK_SIZE - 1) {
+                index += X_STRIDE;
+                return true;
+            }
+            chunk = chunk->neighbors[static_cast<int>(BlockFace::EAST)];
+            index -= (CHUNK_SIZE - 1) * X_STRIDE;
+            return chunk != nullptr;
+    }
+    return false;
+}
+
+// Index in the section of the block at index in its chunk, see SectionLight
+int32_t sectionIndex(const int32_t index) {
+    const auto unsignedIndex = static_cast<uint32_t>(index);
+    return static_cast<int32_t>(unsignedIndex / CHUNK_HEIGHT * SECTION_HEIGHT + unsignedIndex % SECTION_HEIGHT);
+}
+
+LightEngine::LightChunk::LightChunk(Chunk blocks): blocks(std::move(blocks)) {}
+
+uint8_t LightEngine::getLight(const LightChunk &chunk, const int32_t index) {
+    return chunk.lights[static_cast<uint32_t>(index) % CHUNK_HEIGHT / SECTION_HEIGHT].get(sectionIndex(index));
+}
+
+uint8_t LightEngine::getProperties(const LightChunk &chunk, const int32_t index) {
+    const auto unsignedIndex = static_cast<uint32_t>(index);
+    const uint32_t y = unsignedIndex % CHUNK_HEIGHT;
+    const uint32_t z = unsignedIndex / Z_STRIDE % CHUNK_SIZE;
+    const uint32_t x = unsignedIndex / X_STRIDE;
+    return getLightProperties(chunk.blocks.getBlockUnchecked(x, y, z));
+}
+
+void LightEngine::setLight(LightChunk &chunk, const int32_t index, const uint8_t light) {
+    const auto unsignedIndex = static_cast<uint32_t>(index);
+    const uint32_t y = unsignedIndex % CHUNK_HEIGHT;
+    const uint32_t z = unsignedIndex / Z_STRIDE % CHUNK_SIZE;
+    const uint32_t x = unsignedIndex / X_STRIDE;
+    const uint32_t section = y / SECTION_HEIGHT;
+    chunk.lights[section].set(sectionIndex(index), light);
+    chunk.changedSections |= 1 << section;
+
+    const auto border = [](const BlockFace face) { return static_cast<uint8_t>(1 << static_cast<int>(face)); };
+    uint8_t &borders = chunk.changedBorders[section];
+    if (y % SECTION_HEIGHT == 0) borders |= border(BlockFace::DOWN);
+    if (y % SECTION_HEIGHT == SECTION_HEIGHT - 1) borders |= border(BlockFace::UP);
+    if (z == 0) borders |= border(BlockFace::NORTH);
+    if (z == CHUNK_SIZE - 1) borders |= border(BlockFace::SOUTH);
+    if (x == 0) borders |= border(BlockFace::WEST);
+    if (x == CHUNK_SIZE - 1) borders |= border(BlockFace::EAST);
+}
+
+uint8_t LightEngine::getSourceLevel(const LightChunk &chunk, const int32_t index, const bool sky) {
+    const uint8_t properties = getProperties(chunk, index);
+    if (!sky)
+        return properties & BLOCK_LIGHT_MASK;
+    const bool skyAbove = chunk.openSky[index / CHUNK_HEIGHT] && !chunk.neighbors[static_cast<int>(BlockFace::UP)];
+    return skyAbove && index % CHUNK_HEIGHT == CHUNK_HEIGHT - 1 && !(properties & LIGHT_OPAQUE) ? MAX_LIGHT_LEVEL : 0;
+}
+
+void LightEngine::propagateAdditions(const bool sky) {
+    // Breadth first, so each block is lit to its final level on its first visit
+    for (size_t i = 0; i < additionQueue.size(); i++) {
+        const auto [chunk, index, _] = additionQueue[i];
+        uint8_t level = getChannel(getLight(*chunk, index), sky);
+        if (const uint8_t source = getSourceLevel(*chunk, index, sky); source > level) {
+            level = source;
+            setLight(*chunk, index, withChannel(getLight(*chunk, index), sky, level));
+        }
+        if (level <= 1)
+            continue;
+
+        for (const BlockFace direction : LIGHT_DIRECTIONS) {
+            LightChunk* neighbor = chunk;
+            int32_t neighborIndex = index;
+            if (!step(neighbor, neighborIndex, direction) || getProperties(*neighbor, neighborIndex) & LIGHT_OPAQUE)
+                continue;
+
+            // Full sky light goes down without dimming
+            const uint8_t neighborLevel = sky && direction == BlockFace::DOWN && level == MAX_LIGHT_LEVEL ? level : level - 1;
+            const uint8_t light = getLight(*neighbor, neighborIndex);
+            if (getChannel(light, sky) < neighborLevel) {
+                setLight(*neighbor, neighborIndex, withChannel(light, sky, neighborLevel));
+                additionQueue.push_back({ neighbor, neighborIndex, 0 });
+            }
+        }
+    }
+    additionQueue.clear();
+}
+
+void LightEngine::propagateRemovals(const bool sky) {
+    for (size_t i = 0; i < removalQueue.size(); i++) {
+        const auto [chunk, index, level] = removalQueue[i];
+        for (const BlockFace direction : LIGHT_DIRECTIONS) {
+            LightChunk* neighbor = chunk;
+            int32_t neighborIndex = index;
+            if (!step(neighbor, neighborIndex, direction))
+                continue;
+            const uint8_t light = getLight(*neighbor, neighborIndex);
+            const uint8_t neighborLevel = getChannel(light, sky);
+            if (neighborLevel == 0)
+                continue;
+
+            // Dimmer light, or full sky light below, may have come from the removed light: remove it too, and
+            // light sources spread theirs again afterwards. Other light spreads back into the removed area.
+            if (neighborLevel < level || (sky && direction == BlockFace::DOWN && level == MAX_LIGHT_LEVEL)) {
+                setLight(*neighbor, neighborIndex, withChannel(light, sky, 0));
+                removalQueue.push_back({ neighbor, neighborIndex, neighborLevel });
+                if (getSourceLevel(*neighbor, neighborIndex, sky) > 0)
+                    additionQueue.push_back({ neighbor, neighborIndex, 0 });
+            } else {
+                additionQueue.push_back({ neighbor, neighborIndex, 0 });
+            }
+        }
+    }
+    removalQueue.clear();
+}
+
+bool LightEngine::canLightNeighbors(const LightChunk &chunk, const int32_t index, const bool sky) const {
+    if (!sky)
+        return true;
+    const int32_t y = index % CHUNK_HEIGHT;
+    const int32_t z = index / Z_STRIDE % CHUNK_SIZE;
+    const int32_t x = index / X_STRIDE;
+    if (x == 0 || x == CHUNK_SIZE - 1 || y == 0 || y == CHUNK_HEIGHT - 1 || z == 0 || z == CHUNK_SIZE - 1)
+        return true;
+
+    for (const int32_t neighbor : { index - X_STRIDE, index + X_STRIDE, index - Z_STRIDE, index + Z_STRIDE }) {
+        if (!(loadProperties[neighbor] & LIGHT_OPAQUE) && getSkyLight(getLight(chunk, neighbor)) < MAX_LIGHT_LEVEL - 1)
+            return true;
+    }
+    return false;
+}
+
+void LightEngine::loadChunk(Chunk blocks, const SkyColumns &openSky, const uint64_t loadId) {
+    const Vec3i chunkCoordinate = blocks.getChunkCoordinate();
+    std::unique_ptr<LightChunk> &slot = chunks[chunkCoordinate];
+    if (!slot)
+        slot = std::make_unique<LightChunk>(std::move(blocks));
+    else
+        slot->blocks = std::move(blocks);
+    LightChunk &chunk = *slot;
+    chunk.openSky = openSky;
+    chunk.loadId = loadId;
+
+    chunk.neighbors = {};
+    for (const auto &[side, opposite, dx, dy, dz] : LIGHT_NEIGHBOR_SIDES) {
+        const auto it = chunks.find({chunkCoordinate.x + dx, chunkCoordinate.y + dy, chunkCoordinate.z + dz});
+        if (it == chunks.end())
+            continue;
+        chunk.neighbors[static_cast<int>(side)] = it->second.get();
+        it->second->neighbors[static_cast<int>(opposite)] = &chunk;
+    }
+    const LightChunk* above = chunk.neighbors[static_cast<int>(BlockFace::UP)];
+    LightChunk* below = chunk.neighbors[static_cast<int>(BlockFace::DOWN)];
+
+    // Sky light falls straight down until the first opaque block, block light starts at the emitting blocks
+    std::array<block_id, CHUNK_HEIGHT> columnBlocks;
+    for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+        for (int32_t z = 0; z < CHUNK_SIZE; z++) {
+            const int32_t column = columnIndex(x, z);
+            chunk.blocks.copyColumn(x, z, 0, CHUNK_HEIGHT, columnBlocks.data());
+            bool skyVisible = above ? getSkyLight(getLight(*above, column)) == MAX_LIGHT_LEVEL
+                : openSky[x * CHUNK_SIZE + z];
+            for (int32_t y = CHUNK_HEIGHT - 1; y >= 0; y--) {
+                const uint8_t properties = getLightProperties(columnBlocks[y]);
+                skyVisible = skyVisible && !(properties & LIGHT_OPAQUE);
+                loadProperties[column + y] = properties;
+                loadLights[y / SECTION_HEIGHT][sectionIndex(column + y)] =
+                    (skyVisible ? FULL_SKY_LIGHT : 0) | (properties & BLOCK_LIGHT_MASK);
+            }
+        }
+    }
+    for (int32_t section = 0; section < SECTIONS_PER_CHUNK; section++) {
+        chunk.lights[section].assign(loadLights[section]);
+    }
+    chunk.changedSections = (1 << SECTIONS_PER_CHUNK) - 1;
+    chunk.changedBorders.fill((1 << BLOCK_FACE_COUNT) - 1);
+    chunk.justLoaded = true;
+
+    // The chunk below loses the full sky light that came from above where this chunk blocks it
+    if (below) {
+        for (int32_t column = 0; column < CHUNK_VOLUME; column += CHUNK_HEIGHT) {
+            const int32_t top = column + CHUNK_HEIGHT - 1;
+            const uint8_t light = getLight(*below, top);
+            if (getSkyLight(light) == MAX_LIGHT_LEVEL && getSkyLight(getLight(chunk, column)) < MAX_LIGHT_LEVEL) {
+                setLight(*below, top, withChannel(light, true, 0));
+                removalQueue.push_back({ below, top, MAX_LIGHT_LEVEL });
+            }
+        }
+        propagateRemovals(true);
+    }
+
+    for (const bool sky : {true, false}) {
+        for (int32_t index = 0; index < CHUNK_VOLUME; index++) {
+            if (getChannel(getLight(chunk, index), sky) > 1 && canLightNeighbors(chunk, index, sky))
+                additionQueue.push_back({ &chunk, index, 0 });
+        }
+        // Light of the neighbours' blocks along the border spreads into the chunk
+        for (const auto &[side, opposite, dx, dy, dz] : LIGHT_NEIGHBOR_SIDES) {
+            LightChunk* neighbor = chunk.neighbors[static_cast<int>(side)];
+            if (!neighbor)
+                continue;
+            for (int32_t a = 0; a < CHUNK_SIZE; a++) {
+                for (int32_t b = 0; b < faceLayerHeight(opposite); b++) {
+                    const int32_t index = faceLayerIndex(opposite, a, b);
+                    if (getChannel(getLight(*neighbor, index), sky) > 1)
+                        additionQueue.push_back({ neighbor, index, 0 });
+                }
+            }
+        }
+        propagateAdditions(sky);
+    }
+}
+
+void LightEngine::unloadChunk(const Vec3i chunkCoordinate) {
+    const auto it = chunks.find(chunkCoordinate);
+    if (it == chunks.end())
+        return;
+
+    for (const auto &[side, opposite, dx, dy, dz] : LIGHT_NEIGHBOR_SIDES) {
+        if (LightChunk* neighbor = it->second->neighbors[static_cast<int>(side)])
+            neighbor->neighbors[static_cast<int>(opposite)] = nullptr;
+    }
+
+    // Sky light enters the columns of the chunk below that are open to the sky again from above
+    LightChunk* below = it->second->neighbors[static_cast<int>(BlockFace::DOWN)];
+    chunks.erase(it);
+    if (below && below->openSky.any()) {
+        for (int32_t column = 0; column < CHUNK_VOLUME; column += CHUNK_HEIGHT) {
+            if (below->openSky[column / CHUNK_HEIGHT])
+                additionQueue.push_back({ below, column + CHUNK_HEIGHT - 1, 0 });
+        }
+        propagateAdditions(true);
+    }
+}
+
+void LightEngine::setBlocks(const Vec3i min, const Vec3i max, const std::span<const block_id> blocks) {
+    const auto it = chunks.find(blockPosToChunkPos(min));
+    if (it == chunks.end())
+        return;
+    LightChunk &chunk = *it->second;
+
+    const Vec3i origin = chunkPosToBlockPos(it->first);
+    const Vec3i chunkMin(min.x - origin.x, min.y - origin.y, min.z - origin.z);
+    const Vec3i chunkMax(max.x - origin.x, max.y - origin.y, max.z - origin.z);
+    const block_id* column = blocks.data();
+    const int32_t columnHeight = chunkMax.y - chunkMin.y + 1;
+    for (int32_t x = chunkMin.x; x <= chunkMax.x; x++) {
+        for (int32_t z = chunkMin.z; z <= chunkMax.z; z++) {
+            chunk.blocks.pasteColumn(x, z, chunkMin.y, chunkMax.y + 1, column, false);
+            column += columnHeight;
+        }
+    }
+
+    for (const bool sky : {true, false}) {
+        for (int32_t x = chunkMin.x; x <= chunkMax.x; x++) {
+            for (int32_t z = chunkMin.z; z <= chunkMax.z; z++) {
+                for (int32_t y = chunkMin.y; y <= chunkMax.y; y++) {
+                    // The changed blocks lose their light, then get back their own and the light around them
+                    const int32_t index = columnIndex(x, z) + y;
+                    const uint8_t light = getLight(chunk, index);
+                    if (const uint8_t level = getChannel(light, sky); level > 0) {
+                        setLight(chunk, index, withChannel(light, sky, 0));
+                        removalQueue.push_back({ &chunk, index, level });
+                    }
+                    additionQueue.push_back({ &chunk, index, 0 });
+
+                    // Blocks around the box may light it now that it is transparent
+                    if (x != chunkMin.x && x != chunkMax.x && y != chunkMin.y && y != chunkMax.y
+                            && z != chunkMin.z && z != chunkMax.z)
+                        continue;
+                    for (const BlockFace direction : LIGHT_DIRECTIONS) {
+                        LightChunk* neighbor = &chunk;
+                        int32_t neighborIndex = index;
+                        if (step(neighbor, neighborIndex, direction) && getChannel(getLight(*neighbor, neighborIndex), sky) > 0)
+                            additionQueue.push_back({ neighbor, neighborIndex, 0 });
+                    }
+                }
+            }
+        }
+        propagateRemovals(sky);
+        propagateAdditions(sky);
+    }
+}
+
+std::vector<LightUpdate> LightEngine::collectUpdates() {
+    std::vector<LightUpdate> updates;
+    for (auto &[chunkCoordinate, chunk] : chunks) {
+        for (int32_t section = 0; section < SECTIONS_PER_CHUNK; section++) {
+            if (!(chunk->changedSections & 1 << section))
+                continue;
+
+            // Sections lit uniformly again, like those the light of a removed light source left, store one value
+            SectionLight &light = chunk->lights[section];
+            light.compact();
+            updates.emplace_back(chunkCoordinate, section, light.share(), chunk->changedBorders[section],
+                chunk->justLoaded, chunk->loadId);
+        }
+        chunk->changedSections = 0;
+        chunk->changedBorders = {};
+        chunk->justLoaded = false;
+    }
+    return updates;
+}
+
+uint8_t LightEngine::getLight(const Vec3i pos) const {
+    const auto it = chunks.find(blockPosToChunkPos(pos));
+    if (it == chunks.end())
+        return 0;
+    const Vec3i origin = chunkPosToBlockPos(it->first);
+    return getLight(*it->second, columnIndex(pos.x - origin.x, pos.z - origin.z) + pos.y - origin.y);
+}
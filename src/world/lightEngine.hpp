@@ -0,0 +1,105 @@
+#ifndef VOXELS_LIGHTENGINE_HPP
+#define VOXELS_LIGHTENGINE_HPP
+
+#include <array>
+#include <bitset>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/block.hpp"
+#include "world/chunk.hpp"
+#include "world/sectionLight.hpp"
+
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT)
+
+// Columns of a chunk, indexed by x then z, with nothing opaque above the chunk.
+using SkyColumns = std::bitset<CHUNK_SIZE * CHUNK_SIZE>;
+
+// Light of a chunk section changed by the light engine.
+struct LightUpdate {
+    Vec3i chunkCoordinate;
+    int32_t section;
+    SectionLight light;
+    // Faces of the section whose outer layer of blocks changed, as bits indexed by BlockFace. Meshes of the
+    // sections across those faces show the light of this one on their faces towards it.
+    uint8_t changedBorders;
+    // Whether the light of the chunk was computed for the first time since it was loaded
+    bool chunkLoaded;
+    uint64_t loadId; // Given to the load of the chunk, see LightEngine::loadChunk
+};
+
+/**
+ * Sky and block light of the loaded chunks, flood filled breadth first. Sky light comes straight down
+ * at full level through transparent blocks, from the top of the columns of the loaded chunks that are open
+ * to the sky, and spreads with block light one level dimmer per block in every direction. Light does not
+ * enter opaque blocks, which only hold the light they emit.
+ *
+ * Block changes are applied incrementally: the light of the changed blocks is removed along with the light
+ * that came through them, then spread again from the light left around them. Light crosses chunk borders,
+ * chunks that are not loaded are treated as dark and opaque.
+ *
+ * The engine keeps its own palette-compressed copy of the blocks and the light of each section, so it can run
+ * on its own thread, see LightWorker. Chunks are given the light it computes without copying it, see
+ * SectionLight.
+ */
+class LightEngine {
+    // Blocks and light of a loaded chunk. Blocks inside a chunk are indexed by column then y.
+    struct LightChunk {
+        Chunk blocks;
+        std::array<SectionLight, SECTIONS_PER_CHUNK> lights;
+        std::array<LightChunk*, BLOCK_FACE_COUNT> neighbors {}; // Indexed by BlockFace, nullptr where not loaded
+        std::array<uint8_t, SECTIONS_PER_CHUNK> changedBorders {};
+        uint8_t changedSections = 0; // Bit per section
+        bool justLoaded = false; // Whether updates have not been collected since the chunk was loaded
+        uint64_t loadId = 0;
+        SkyColumns openSky; // Columns full sky light enters from above while the chunk above is not loaded
+
+        explicit LightChunk(Chunk blocks);
+    };
+
+    struct QueuedLight {
+        LightChunk* chunk;
+        int32_t index;
+        uint8_t level; // Level removed, for the removal queue
+    };
+
+    unordered_map<Vec3i, std::unique_ptr<LightChunk>> chunks;
+    std::vector<QueuedLight> removalQueue;
+    std::vector<QueuedLight> additionQueue;
+    // Light and light properties of the chunk being loaded, before they are stored in its sections
+    std::array<std::array<uint8_t, SECTION_VOLUME>, SECTIONS_PER_CHUNK> loadLights;
+    std::array<uint8_t, CHUNK_VOLUME> loadProperties;
+
+    [[nodiscard]] static uint8_t getLight(const LightChunk &chunk, int32_t index);
+    // Light emitted by the block, with LIGHT_OPAQUE set for opaque blocks
+    [[nodiscard]] static uint8_t getProperties(const LightChunk &chunk, int32_t index);
+    void setLight(LightChunk &chunk, int32_t index, uint8_t light);
+    // Level a block has regardless of its surroundings: the light it emits, or full sky light at the top of a chunk
+    // open to the sky
+    [[nodiscard]] static uint8_t getSourceLevel(const LightChunk &chunk, int32_t index, bool sky);
+    // Whether the block at index of a freshly loaded chunk may light an adjacent block of the chunk, or is on the
+    // chunk's border. Blocks under open sky only light the sides of their column where there is no open sky.
+    [[nodiscard]] bool canLightNeighbors(const LightChunk &chunk, int32_t index, bool sky) const;
+    // Spreads the light of the cells in the addition queue, for sky light when sky is set and block light otherwise
+    void propagateAdditions(bool sky);
+    // Darkens the cells of the removal queue and the cells lit through them, queuing the light around them for addition
+    void propagateRemovals(bool sky);
+
+public:
+    // Takes a copy of the chunk's blocks, see Chunk::copyBlocks. Sky light comes down into the openSky columns
+    // while the chunk above is not loaded. The chunk's updates carry loadId until it is loaded again.
+    void loadChunk(Chunk blocks, const SkyColumns &openSky, uint64_t loadId = 0);
+    void unloadChunk(Vec3i chunkCoordinate);
+    // Changes the blocks between min and max, both inclusive and within a single chunk, given like a column-major
+    // box of blocks. Changes to chunks that are not loaded are ignored.
+    void setBlocks(Vec3i min, Vec3i max, std::span<const block_id> blocks);
+
+    // Returns the light of the sections changed since the last call.
+    [[nodiscard]] std::vector<LightUpdate> collectUpdates();
+    // Light at a world position, 0 outside the loaded chunks.
+    [[nodiscard]] uint8_t getLight(Vec3i pos) const;
+};
+
+#endif //VOXELS_LIGHTENGINE_HPP
@@ -0,0 +1,79 @@
+#include "world/lightWorker.hpp"
+
+#include <utility>
+
+#include "world/chunk.hpp"
+
+LightWorker::LightWorker() {
+    worker = std::thread(&LightWorker::work, this);
+}
+
+LightWorker::~LightWorker() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_one();
+    worker.join();
+}
+
+void LightWorker::submit(LightTask task) {
+    {
+        std::lock_guard lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void LightWorker::loadChunk(Chunk blocks, const SkyColumns &openSky, const uint64_t loadId) {
+    const Vec3i pos = blocks.getOrigin();
+    submit({ TaskType::LOAD_CHUNK, pos, pos, {},
+        std::make_unique<ChunkLoad>(ChunkLoad { std::move(blocks), openSky, loadId }) });
+}
+
+void LightWorker::unloadChunk(const Vec3i chunkCoordinate) {
+    const Vec3i pos = chunkPosToBlockPos(chunkCoordinate);
+    submit({ TaskType::UNLOAD_CHUNK, pos, pos, {}, nullptr });
+}
+
+void LightWorker::setBlocks(const Vec3i min, const Vec3i max, std::vector<block_id> blocks) {
+    submit({ TaskType::SET_BLOCKS, min, max, std::move(blocks), nullptr });
+}
+
+std::vector<LightUpdate> LightWorker::collectUpdates() {
+    std::lock_guard lock(mutex);
+    return std::exchange(updates, {});
+}
+
+void LightWorker::work() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (stopping)
+            return;
+
+        // Tasks queued together are applied before their updates are collected, so a section changed by
+        // several of them is sent once
+        std::deque<LightTask> batch = std::exchange(tasks, {});
+        lock.unlock();
+
+        for (LightTask &task : batch) {
+            switch (task.type) {
+                case TaskType::LOAD_CHUNK:
+                    engine.loadChunk(std::move(task.load->blocks), task.load->openSky, task.load->loadId);
+                    break;
+                case TaskType::UNLOAD_CHUNK:
+                    engine.unloadChunk(blockPosToChunkPos(task.min));
+                    break;
+                case TaskType::SET_BLOCKS:
+                    engine.setBlocks(task.min, task.max, task.blocks);
+                    break;
+            }
+        }
+        std::vector<LightUpdate> batchUpdates = engine.collectUpdates();
+
+        lock.lock();
+        updates.insert(updates.end(), std::make_move_iterator(batchUpdates.begin()),
+            std::make_move_iterator(batchUpdates.end()));
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef VOXELS_LIGHTWORKER_HPP
+#define VOXELS_LIGHTWORKER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "world/lightEngine.hpp"
+
+/**
+ * Thread running a LightEngine, so relighting after a block change or a chunk load never stalls the render
+ * thread. Changes are applied in the order they are queued, and the light of the changed sections is
+ * collected once ready.
+ */
+class LightWorker {
+    enum class TaskType {
+        LOAD_CHUNK,
+        UNLOAD_CHUNK,
+        SET_BLOCKS
+    };
+
+    struct ChunkLoad {
+        Chunk blocks;
+        SkyColumns openSky;
+        uint64_t loadId;
+    };
+
+    struct LightTask {
+        TaskType type;
+        Vec3i min; // A block of the chunk for chunk tasks
+        Vec3i max;
+        std::vector<block_id> blocks;
+        std::unique_ptr<ChunkLoad> load; // For chunk loads, kept out of the task so queued tasks stay small
+    };
+
+    LightEngine engine; // Only used by the worker thread
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::deque<LightTask> tasks;
+    std::vector<LightUpdate> updates;
+    bool stopping = false;
+
+    void work();
+    void submit(LightTask task);
+
+public:
+    LightWorker();
+    ~LightWorker();
+
+    LightWorker(const LightWorker&) = delete;
+    LightWorker& operator=(const LightWorker&) = delete;
+
+    // Same as the LightEngine functions, applied in the background.
+    void loadChunk(Chunk blocks, const SkyColumns &openSky, uint64_t loadId);
+    void unloadChunk(Vec3i chunkCoordinate);
+    void setBlocks(Vec3i min, Vec3i max, std::vector<block_id> blocks);
+    // Returns the light of the sections changed by the tasks completed since the last call, without waiting.
+    [[nodiscard]] std::vector<LightUpdate> collectUpdates();
+};
+
+#endif //VOXELS_LIGHTWORKER_HPP
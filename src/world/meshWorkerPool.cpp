@@ -0,0 +1,63 @@
+#include "world/meshWorkerPool.hpp"
+
+#include <utility>
+
+MeshWorkerPool::MeshWorkerPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&MeshWorkerPool::work, this);
+    }
+}
+
+MeshWorkerPool::~MeshWorkerPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void MeshWorkerPool::submit(MeshJob job) {
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+std::vector<MeshResult> MeshWorkerPool::collectResults() {
+    std::lock_guard lock(mutex);
+    return std::exchange(results, {});
+}
+
+void MeshWorkerPool::work() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (stopping)
+            return;
+
+        MeshJob job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+
+        std::vector<uint32_t> mesh = ChunkMesher::buildMesh(*job.snapshot, *job.atlasLayout, job.meshingMode);
+        job.snapshot.reset();
+
+        lock.lock();
+        results.push_back({
+            job.chunkCoordinate,
+            job.section,
+            std::move(mesh),
+            job.id
+        });
+    }
+}
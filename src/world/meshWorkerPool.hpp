@@ -0,0 +1,57 @@
+#ifndef VOXELS_MESHWORKERPOOL_HPP
+#define VOXELS_MESHWORKERPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "world/chunkMesher.hpp"
+
+struct MeshJob {
+    Vec3i chunkCoordinate;
+    int32_t section;
+    uint64_t id; // Unique per world, to tell the results of jobs for an unloaded chunk from the reloaded chunk's
+    MeshingMode meshingMode;
+    const AtlasLayout* atlasLayout; // Must outlive the pool, which joins its workers when destroyed
+    std::unique_ptr<SectionSnapshot> snapshot;
+};
+
+struct MeshResult {
+    Vec3i chunkCoordinate;
+    int32_t section;
+    std::vector<uint32_t> mesh;
+    uint64_t jobId = 0; // 0 for sections known to have an empty mesh, meshed without a job
+};
+
+/**
+ * Pool of threads building chunk section meshes in the background. Jobs are submitted and results
+ * collected from the render thread, which stays responsible for uploading meshes to the GPU.
+ */
+class MeshWorkerPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::deque<MeshJob> jobs;
+    std::vector<MeshResult> results;
+    bool stopping = false;
+
+    void work();
+
+public:
+    // Uses one thread per core, leaving one for the render thread, when threadCount is 0.
+    explicit MeshWorkerPool(unsigned int threadCount = 0);
+    // Drops the queued jobs and waits for the running ones to finish.
+    ~MeshWorkerPool();
+
+    MeshWorkerPool(const MeshWorkerPool&) = delete;
+    MeshWorkerPool& operator=(const MeshWorkerPool&) = delete;
+
+    void submit(MeshJob job);
+    // Returns the meshes finished since the last call, without waiting.
+    [[nodiscard]] std::vector<MeshResult> collectResults();
+};
+
+#endif //VOXELS_MESHWORKERPOOL_HPP
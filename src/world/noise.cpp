@@ -0,0 +1,40 @@
+#include "world/noise.hpp"
+
+#include "world/noiseKernel.hpp"
+
+using FractalNoiseKernel = void (*)(const FractalNoise&, const float*, const float*, const float*, float*, size_t);
+
+struct NoiseKernel {
+    FractalNoiseKernel fractal3D;
+    const char* instructionSet;
+};
+
+void fractalNoiseScalar(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, const size_t count) {
+    fractalKernel<ScalarOps>(noise, x, y, z, out, count);
+}
+
+// Picks the widest kernel supported by the CPU. The vectorized kernels are only built
+// when VOXELS_X86_NOISE_KERNELS is defined.
+NoiseKernel selectKernel() {
+#if defined(VOXELS_X86_NOISE_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return { fractalNoiseAvx2, "AVX2" };
+    if (__builtin_cpu_supports("sse4.1"))
+        return { fractalNoiseSse41, "SSE4.1" };
+#endif
+    return { fractalNoiseScalar, "scalar" };
+}
+
+const NoiseKernel& getKernel() {
+    static const NoiseKernel kernel = selectKernel();
+    return kernel;
+}
+
+void Noise::fractal3D(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, const size_t count) {
+    getKernel().fractal3D(noise, x, y, z, out, count);
+}
+
+const char* Noise::getInstructionSet() {
+    return getKernel().instructionSet;
+}
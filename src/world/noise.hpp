@@ -0,0 +1,29 @@
+#ifndef VOXELS_NOISE_HPP
+#define VOXELS_NOISE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Sum of octaves of gradient noise, each one at lacunarity times the frequency and
+// persistence times the amplitude of the previous one.
+struct FractalNoise {
+    uint32_t seed;
+    int octaves;
+    float frequency;
+    float persistence = 0.5f;
+    float lacunarity = 2.0f;
+};
+
+/**
+ * Batched 3D gradient noise. Kernels are vectorized with AVX2 or SSE4.1 when the CPU supports them,
+ * with a scalar fallback. Every kernel gives bit-identical results, so a seed always generates the
+ * same terrain.
+ */
+namespace Noise {
+    // Evaluates the noise at count points, writing values roughly in [-1, 1] to out.
+    void fractal3D(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, size_t count);
+    // Name of the instruction set used by fractal3D.
+    [[nodiscard]] const char* getInstructionSet();
+}
+
+#endif //VOXELS_NOISE_HPP
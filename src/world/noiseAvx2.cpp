@@ -0,0 +1,39 @@
+// Compiled with AVX2 enabled, only called on CPUs supporting it
+#include "world/noiseKernel.hpp"
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+namespace {
+    struct Avx2Ops {
+        using Float = __m256;
+        using Int = __m256i;
+        static constexpr size_t WIDTH = 8;
+
+        static Float load(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, const Float v) { _mm256_storeu_ps(p, v); }
+        static Float set(const float v) { return _mm256_set1_ps(v); }
+        static Int seti(const uint32_t v) { return _mm256_set1_epi32(static_cast<int32_t>(v)); }
+
+        static Float add(const Float a, const Float b) { return _mm256_add_ps(a, b); }
+        static Float sub(const Float a, const Float b) { return _mm256_sub_ps(a, b); }
+        static Float mul(const Float a, const Float b) { return _mm256_mul_ps(a, b); }
+        static Float floor(const Float v) { return _mm256_floor_ps(v); }
+        static Int toInt(const Float v) { return _mm256_cvttps_epi32(v); }
+
+        static Int addi(const Int a, const Int b) { return _mm256_add_epi32(a, b); }
+        static Int muli(const Int a, const Int b) { return _mm256_mullo_epi32(a, b); }
+        static Int xori(const Int a, const Int b) { return _mm256_xor_si256(a, b); }
+        static Int andi(const Int a, const Int b) { return _mm256_and_si256(a, b); }
+        static Int srli(const Int v, const int shift) { return _mm256_srli_epi32(v, shift); }
+        static Int slli(const Int v, const int shift) { return _mm256_slli_epi32(v, shift); }
+        static Float flipSign(const Float v, const Int sign) { return _mm256_xor_ps(v, _mm256_castsi256_ps(sign)); }
+    };
+}
+
+void fractalNoiseAvx2(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, const size_t count) {
+    fractalKernel<Avx2Ops>(noise, x, y, z, out, count);
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef VOXELS_NOISEKERNEL_HPP
+#define VOXELS_NOISEKERNEL_HPP
+
+#include <bit>
+#include <cmath>
+
+#include "world/noise.hpp"
+
+/*
+ * Gradient noise kernel shared by every instruction set. Each translation unit instantiates it
+ * with its own vector operations, compiled with its own target flags. Everything here has internal
+ * linkage, so the linker never merges code built for different instruction sets.
+ *
+ * Ops provides WIDTH lanes of Float (float) and Int (uint32_t) values, see ScalarOps.
+ */
+namespace {
+    constexpr uint32_t PRIME_X = 0x9E3779B1u;
+    constexpr uint32_t PRIME_Y = 0x85EBCA77u;
+    constexpr uint32_t PRIME_Z = 0xC2B2AE3Du;
+    // Brings the sum of octaves back to about [-1, 1]
+    constexpr float NOISE_SCALE = 0.9f;
+
+    struct ScalarOps {
+        using Float = float;
+        using Int = uint32_t;
+        static constexpr size_t WIDTH = 1;
+
+        static Float load(const float* p) { return *p; }
+        static void store(float* p, const Float v) { *p = v; }
+        static Float set(const float v) { return v; }
+        static Int seti(const uint32_t v) { return v; }
+
+        static Float add(const Float a, const Float b) { return a + b; }
+        static Float sub(const Float a, const Float b) { return a - b; }
+        static Float mul(const Float a, const Float b) { return a * b; }
+        static Float floor(const Float v) { return std::floor(v); }
+        static Int toInt(const Float v) { return static_cast<uint32_t>(static_cast<int32_t>(v)); }
+
+        static Int addi(const Int a, const Int b) { return a + b; }
+        static Int muli(const Int a, const Int b) { return a * b; }
+        static Int xori(const Int a, const Int b) { return a ^ b; }
+        static Int andi(const Int a, const Int b) { return a & b; }
+        static Int srli(const Int v, const int shift) { return v >> shift; }
+        static Int slli(const Int v, const int shift) { return v << shift; }
+        // Flips the sign of v where the sign bit of sign is set
+        static Float flipSign(const Float v, const Int sign) {
+            return std::bit_cast<float>(std::bit_cast<uint32_t>(v) ^ sign);
+        }
+    };
+
+    template<typename Ops>
+    typename Ops::Int hash(typename Ops::Int h) {
+        h = Ops::xori(h, Ops::srli(h, 16));
+        h = Ops::muli(h, Ops::seti(0x7FEB352Du));
+        h = Ops::xori(h, Ops::srli(h, 15));
+        h = Ops::muli(h, Ops::seti(0x846CA68Bu));
+        return Ops::xori(h, Ops::srli(h, 16));
+    }
+
+    // Dot product of the offset from a lattice corner with the corner's gradient,
+    // one of the 8 diagonals (+-1, +-1, +-1) picked by the corner's hash.
+    template<typename Ops>
+    typename Ops::Float cornerValue(const typename Ops::Int seed, const typename Ops::Int xHash,
+            const typename Ops::Int yHash, const typename Ops::Int zHash,
+            const typename Ops::Float dx, const typename Ops::Float dy, const typename Ops::Float dz) {
+        const typename Ops::Int h = hash<Ops>(Ops::xori(Ops::xori(seed, xHash), Ops::xori(yHash, zHash)));
+        const typename Ops::Int signBit = Ops::seti(0x80000000u);
+        const typename Ops::Float x = Ops::flipSign(dx, Ops::andi(Ops::slli(h, 31), signBit));
+        const typename Ops::Float y = Ops::flipSign(dy, Ops::andi(Ops::slli(h, 30), signBit));
+        const typename Ops::Float z = Ops::flipSign(dz, Ops::andi(Ops::slli(h, 29), signBit));
+        return Ops::add(Ops::add(x, y), z);
+    }
+
+    template<typename Ops>
+    typename Ops::Float lerp(const typename Ops::Float a, const typename Ops::Float b, const typename Ops::Float t) {
+        return Ops::add(a, Ops::mul(Ops::sub(b, a), t));
+    }
+
+    // Quintic fade curve 6t^5 - 15t^4 + 10t^3, with zero first and second derivatives at 0 and 1
+    template<typename Ops>
+    typename Ops::Float fade(const typename Ops::Float t) {
+        const typename Ops::Float inner = Ops::add(Ops::mul(t, Ops::sub(Ops::mul(t, Ops::set(6.0f)), Ops::set(15.0f))), Ops::set(10.0f));
+        return Ops::mul(Ops::mul(Ops::mul(t, t), t), inner);
+    }
+
+    template<typename Ops>
+    typename Ops::Float gradientNoise(const typename Ops::Int seed, const typename Ops::Float x,
+            const typename Ops::Float y, const typename Ops::Float z) {
+        const typename Ops::Float xFloor = Ops::floor(x);
+        const typename Ops::Float yFloor = Ops::floor(y);
+        const typename Ops::Float zFloor = Ops::floor(z);
+        const typename Ops::Float dx0 = Ops::sub(x, xFloor);
+        const typename Ops::Float dy0 = Ops::sub(y, yFloor);
+        const typename Ops::Float dz0 = Ops::sub(z, zFloor);
+        const typename Ops::Float one = Ops::set(1.0f);
+        const typename Ops::Float dx1 = Ops::sub(dx0, one);
+        const typename Ops::Float dy1 = Ops::sub(dy0, one);
+        const typename Ops::Float dz1 = Ops::sub(dz0, one);
+
+        const typename Ops::Int x0 = Ops::muli(Ops::toInt(xFloor), Ops::seti(PRIME_X));
+        const typename Ops::Int y0 = Ops::muli(Ops::toInt(yFloor), Ops::seti(PRIME_Y));
+        const typename Ops::Int z0 = Ops::muli(Ops::toInt(zFloor), Ops::seti(PRIME_Z));
+        const typename Ops::Int x1 = Ops::addi(x0, Ops::seti(PRIME_X));
+        const typename Ops::Int y1 = Ops::addi(y0, Ops::seti(PRIME_Y));
+        const typename Ops::Int z1 = Ops::addi(z0, Ops::seti(PRIME_Z));
+
+        const typename Ops::Float u = fade<Ops>(dx0);
+        const typename Ops::Float v = fade<Ops>(dy0);
+        const typename Ops::Float w = fade<Ops>(dz0);
+
+        const typename Ops::Float x00 = lerp<Ops>(cornerValue<Ops>(seed, x0, y0, z0, dx0, dy0, dz0),
+                                                  cornerValue<Ops>(seed, x1, y0, z0, dx1, dy0, dz0), u);
+        const typename Ops::Float x10 = lerp<Ops>(cornerValue<Ops>(seed, x0, y1, z0, dx0, dy1, dz0),
+                                                  cornerValue<Ops>(seed, x1, y1, z0, dx1, dy1, dz0), u);
+        const typename Ops::Float x01 = lerp<Ops>(cornerValue<Ops>(seed, x0, y0, z1, dx0, dy0, dz1),
+                                                  cornerValue<Ops>(seed, x1, y0, z1, dx1, dy0, dz1), u);
+        const typename Ops::Float x11 = lerp<Ops>(cornerValue<Ops>(seed, x0, y1, z1, dx0, dy1, dz1),
+                                                  cornerValue<Ops>(seed, x1, y1, z1, dx1, dy1, dz1), u);
+        return lerp<Ops>(lerp<Ops>(x00, x10, v), lerp<Ops>(x01, x11, v), w);
+    }
+
+    template<typename Ops>
+    void fractalKernel(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out,
+            const size_t count) {
+        float totalAmplitude = 0.0f;
+        float amplitude = 1.0f;
+        for (int octave = 0; octave < noise.octaves; octave++) {
+            totalAmplitude += amplitude;
+            amplitude *= noise.persistence;
+        }
+        const float scale = NOISE_SCALE / totalAmplitude;
+
+        size_t i = 0;
+        for (; i + Ops::WIDTH <= count; i += Ops::WIDTH) {
+            const typename Ops::Float px = Ops::load(x + i);
+            const typename Ops::Float py = Ops::load(y + i);
+            const typename Ops::Float pz = Ops::load(z + i);
+
+            typename Ops::Float sum = Ops::set(0.0f);
+            float frequency = noise.frequency;
+            amplitude = scale;
+            for (int octave = 0; octave < noise.octaves; octave++) {
+                const typename Ops::Float f = Ops::set(frequency);
+                const typename Ops::Float value = gradientNoise<Ops>(Ops::seti(noise.seed + octave),
+                    Ops::mul(px, f), Ops::mul(py, f), Ops::mul(pz, f));
+                sum = Ops::add(sum, Ops::mul(value, Ops::set(amplitude)));
+                frequency *= noise.lacunarity;
+                amplitude *= noise.persistence;
+            }
+            Ops::store(out + i, sum);
+        }
+
+        // Points left over from the last full vector
+        if constexpr (Ops::WIDTH > 1) {
+            if (i < count)
+                fractalKernel<ScalarOps>(noise, x + i, y + i, z + i, out + i, count - i);
+        }
+    }
+}
+
+// Kernels for each instruction set, only available in builds targeting x86
+void fractalNoiseScalar(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, size_t count);
+void fractalNoiseSse41(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, size_t count);
+void fractalNoiseAvx2(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, size_t count);
+
+#endif //VOXELS_NOISEKERNEL_HPP
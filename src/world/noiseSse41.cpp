@@ -0,0 +1,39 @@
+// Compiled with SSE4.1 enabled, only called on CPUs supporting it
+#include "world/noiseKernel.hpp"
+
+#ifdef __SSE4_1__
+
+#include <smmintrin.h>
+
+namespace {
+    struct Sse41Ops {
+        using Float = __m128;
+        using Int = __m128i;
+        static constexpr size_t WIDTH = 4;
+
+        static Float load(const float* p) { return _mm_loadu_ps(p); }
+        static void store(float* p, const Float v) { _mm_storeu_ps(p, v); }
+        static Float set(const float v) { return _mm_set1_ps(v); }
+        static Int seti(const uint32_t v) { return _mm_set1_epi32(static_cast<int32_t>(v)); }
+
+        static Float add(const Float a, const Float b) { return _mm_add_ps(a, b); }
+        static Float sub(const Float a, const Float b) { return _mm_sub_ps(a, b); }
+        static Float mul(const Float a, const Float b) { return _mm_mul_ps(a, b); }
+        static Float floor(const Float v) { return _mm_floor_ps(v); }
+        static Int toInt(const Float v) { return _mm_cvttps_epi32(v); }
+
+        static Int addi(const Int a, const Int b) { return _mm_add_epi32(a, b); }
+        static Int muli(const Int a, const Int b) { return _mm_mullo_epi32(a, b); }
+        static Int xori(const Int a, const Int b) { return _mm_xor_si128(a, b); }
+        static Int andi(const Int a, const Int b) { return _mm_and_si128(a, b); }
+        static Int srli(const Int v, const int shift) { return _mm_srli_epi32(v, shift); }
+        static Int slli(const Int v, const int shift) { return _mm_slli_epi32(v, shift); }
+        static Float flipSign(const Float v, const Int sign) { return _mm_xor_ps(v, _mm_castsi128_ps(sign)); }
+    };
+}
+
+void fractalNoiseSse41(const FractalNoise &noise, const float* x, const float* y, const float* z, float* out, const size_t count) {
+    fractalKernel<Sse41Ops>(noise, x, y, z, out, count);
+}
+
+#endif
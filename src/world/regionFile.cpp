@@ -0,0 +1,165 @@
+#include "world/regionFile.hpp"
+
+#include <algorithm>
+#include <format>
+
+#include "world/binaryStream.hpp"
+#include "logger.hpp"
+
+#define SECTOR_SIZE 4096
+#define LOCATION_BYTES 8
+#define TABLE_SECTORS (REGION_CHUNK_COUNT * LOCATION_BYTES / SECTOR_SIZE)
+// Chunk data is prefixed with its length in bytes
+#define LENGTH_BYTES 4
+
+RegionFile::RegionFile(const std::filesystem::path &path): path(path) {
+    // Opening for both reading and writing requires the file to exist
+    if (!std::filesystem::exists(path))
+        std::ofstream(path, std::ios::binary);
+
+    file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file)
+        Logger::crash("Failed to open region file " + path.string());
+
+    readTable();
+}
+
+int32_t RegionFile::indexOf(const Vec3i chunkCoordinate) {
+    const Vec3i regionPos = chunkPosToRegionPos(chunkCoordinate);
+    const int32_t x = chunkCoordinate.x - regionPos.x * REGION_SIZE;
+    const int32_t y = chunkCoordinate.y - regionPos.y * REGION_SIZE;
+    const int32_t z = chunkCoordinate.z - regionPos.z * REGION_SIZE;
+    return (y * REGION_SIZE + z) * REGION_SIZE + x;
+}
+
+void RegionFile::readTable() {
+    const uintmax_t fileSize = std::filesystem::file_size(path);
+    usedSectors.assign(std::max<uintmax_t>(fileSize / SECTOR_SIZE, TABLE_SECTORS), false);
+    std::fill_n(usedSectors.begin(), TABLE_SECTORS, true);
+
+    if (fileSize < TABLE_SECTORS * SECTOR_SIZE) {
+        if (fileSize > 0)
+            Logger::warn(std::format("Region file {} is truncated, its chunks will be regenerated", path.string()));
+        const std::vector<char> emptyTable(TABLE_SECTORS * SECTOR_SIZE, 0);
+        file.seekp(0);
+        file.write(emptyTable.data(), static_cast<std::streamsize>(emptyTable.size()));
+        file.flush();
+        return;
+    }
+
+    std::vector<uint8_t> table(TABLE_SECTORS * SECTOR_SIZE);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size()));
+    BinaryReader reader(table);
+    int32_t invalidLocations = 0;
+    for (int32_t index = 0; index < REGION_CHUNK_COUNT; index++) {
+        ChunkLocation location;
+        location.firstSector = reader.readU32();
+        location.sectorCount = reader.readU32();
+        if (location.sectorCount == 0)
+            continue;
+
+        const bool inFile = location.firstSector >= TABLE_SECTORS && location.firstSector < usedSectors.size()
+            && location.sectorCount <= usedSectors.size() - location.firstSector;
+        if (!inFile || std::any_of(usedSectors.begin() + location.firstSector,
+                usedSectors.begin() + location.firstSector + location.sectorCount, [](const bool used) { return used; })) {
+            invalidLocations++;
+            continue;
+        }
+        locations[index] = location;
+        setSectorsUsed(location, true);
+    }
+    if (invalidLocations > 0)
+        Logger::warn(std::format("{} chunks of region file {} have an invalid location, they will be regenerated",
+            invalidLocations, path.string()));
+}
+
+void RegionFile::writeLocation(const int32_t index) {
+    BinaryWriter writer;
+    writer.writeU32(locations[index].firstSector);
+    writer.writeU32(locations[index].sectorCount);
+    file.seekp(static_cast<std::streamoff>(index) * LOCATION_BYTES);
+    file.write(reinterpret_cast<const char*>(writer.getBytes().data()), LOCATION_BYTES);
+}
+
+uint32_t RegionFile::findFreeSectors(const uint32_t count) const {
+    uint32_t runStart = TABLE_SECTORS;
+    for (uint32_t sector = TABLE_SECTORS; sector < usedSectors.size(); sector++) {
+        if (usedSectors[sector]) {
+            runStart = sector + 1;
+        } else if (sector + 1 - runStart == count) {
+            return runStart;
+        }
+    }
+    // A free run at the end of the file is extended
+    return runStart;
+}
+
+void RegionFile::setSectorsUsed(const ChunkLocation location, const bool used) {
+    std::fill_n(usedSectors.begin() + location.firstSector, location.sectorCount, used);
+}
+
+std::optional<std::vector<uint8_t>> RegionFile::read(const Vec3i chunkCoordinate) {
+    const ChunkLocation location = locations[indexOf(chunkCoordinate)];
+    if (location.sectorCount == 0)
+        return std::nullopt;
+
+    uint8_t lengthBytes[LENGTH_BYTES];
+    file.seekg(static_cast<std::streamoff>(location.firstSector) * SECTOR_SIZE);
+    file.read(reinterpret_cast<char*>(lengthBytes), LENGTH_BYTES);
+    BinaryReader reader(lengthBytes);
+    const uint32_t length = reader.readU32();
+
+    std::vector<uint8_t> data;
+    if (file && length <= location.sectorCount * SECTOR_SIZE - LENGTH_BYTES) {
+        data.resize(length);
+        file.read(reinterpret_cast<char*>(data.data()), length);
+    }
+    if (!file || data.size() != length) {
+        file.clear();
+        Logger::warn(std::format("Failed to read chunk ({}, {}, {}) from region file {}",
+            chunkCoordinate.x, chunkCoordinate.y, chunkCoordinate.z, path.string()));
+        return std::nullopt;
+    }
+    return data;
+}
+
+void RegionFile::write(const Vec3i chunkCoordinate, const std::span<const uint8_t> data) {
+    const int32_t index = indexOf(chunkCoordinate);
+    ChunkLocation &location = locations[index];
+    const auto sectorCount = static_cast<uint32_t>((LENGTH_BYTES + data.size() + SECTOR_SIZE - 1) / SECTOR_SIZE);
+
+    setSectorsUsed(location, false);
+    if (location.sectorCount < sectorCount)
+        location.firstSector = findFreeSectors(sectorCount);
+    location.sectorCount = sectorCount;
+    if (location.firstSector + sectorCount > usedSectors.size())
+        usedSectors.resize(location.firstSector + sectorCount, false);
+    setSectorsUsed(location, true);
+
+    // Whole sectors are written so the file size stays a multiple of the sector size
+    BinaryWriter writer;
+    writer.writeU32(static_cast<uint32_t>(data.size()));
+    std::vector<uint8_t> sectors = writer.takeBytes();
+    sectors.insert(sectors.end(), data.begin(), data.end());
+    sectors.resize(static_cast<size_t>(sectorCount) * SECTOR_SIZE, 0);
+
+    // The data is written before its location, so a moved chunk stays readable from its previous
+    // sectors if the game stops in between
+    file.seekp(static_cast<std::streamoff>(location.firstSector) * SECTOR_SIZE);
+    file.write(reinterpret_cast<const char*>(sectors.data()), static_cast<std::streamsize>(sectors.size()));
+    writeLocation(index);
+    file.flush();
+    if (!file) {
+        file.clear();
+        Logger::error(std::format("Failed to write chunk ({}, {}, {}) to region file {}",
+            chunkCoordinate.x, chunkCoordinate.y, chunkCoordinate.z, path.string()));
+    }
+}
+
+Vec3i chunkPosToRegionPos(const Vec3i chunkCoordinate) {
+    const int32_t regionX = chunkCoordinate.x >= 0 ? chunkCoordinate.x / REGION_SIZE : (chunkCoordinate.x + 1) / REGION_SIZE - 1;
+    const int32_t regionY = chunkCoordinate.y >= 0 ? chunkCoordinate.y / REGION_SIZE : (chunkCoordinate.y + 1) / REGION_SIZE - 1;
+    const int32_t regionZ = chunkCoordinate.z >= 0 ? chunkCoordinate.z / REGION_SIZE : (chunkCoordinate.z + 1) / REGION_SIZE - 1;
+    return {regionX, regionY, regionZ};
+}
@@ -0,0 +1,52 @@
+#ifndef VOXELS_REGIONFILE_HPP
+#define VOXELS_REGIONFILE_HPP
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "math/vectors.hpp"
+
+// Width in chunks of the cube stored in a region file
+#define REGION_SIZE 16
+#define REGION_CHUNK_COUNT (REGION_SIZE * REGION_SIZE * REGION_SIZE)
+
+/**
+ * File holding the serialized chunks of a REGION_SIZE x REGION_SIZE x REGION_SIZE cube, allocated in 4 KiB sectors.
+ * The file starts with a table giving the first sector and the sector count of each chunk. A chunk
+ * is rewritten in place while it fits in its sectors, and otherwise moved to the first run of free
+ * sectors large enough, so saving a chunk never rewrites the rest of the region.
+ */
+class RegionFile {
+    struct ChunkLocation {
+        uint32_t firstSector = 0;
+        uint32_t sectorCount = 0; // 0 when the chunk was never saved
+    };
+
+    std::filesystem::path path;
+    std::fstream file;
+    std::array<ChunkLocation, REGION_CHUNK_COUNT> locations;
+    std::vector<bool> usedSectors; // One per sector of the file, including the table
+
+    [[nodiscard]] static int32_t indexOf(Vec3i chunkCoordinate);
+    void readTable();
+    void writeLocation(int32_t index);
+    // First sector of a run of count free sectors, past the end of the file if none is free
+    [[nodiscard]] uint32_t findFreeSectors(uint32_t count) const;
+    void setSectorsUsed(ChunkLocation location, bool used);
+
+public:
+    // Opens the region file at path, creating it if needed.
+    explicit RegionFile(const std::filesystem::path &path);
+
+    // The data last written for the chunk, if any. Chunk coordinates are world coordinates.
+    [[nodiscard]] std::optional<std::vector<uint8_t>> read(Vec3i chunkCoordinate);
+    void write(Vec3i chunkCoordinate, std::span<const uint8_t> data);
+};
+
+Vec3i chunkPosToRegionPos(Vec3i chunkCoordinate);
+
+#endif //VOXELS_REGIONFILE_HPP
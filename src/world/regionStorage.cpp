@@ -0,0 +1,51 @@
+#include "world/regionStorage.hpp"
+
+#include <format>
+#include <utility>
+
+#include "logger.hpp"
+
+// Region files are all closed when more would be open at once
+#define MAX_OPEN_REGION_FILES 16
+
+RegionStorage::RegionStorage(std::filesystem::path directory): directory(std::move(directory)) {
+    std::error_code error;
+    std::filesystem::create_directories(this->directory, error);
+    if (error)
+        Logger::crash(std::format("Failed to create save directory {}: {}", this->directory.string(), error.message()));
+}
+
+RegionFile* RegionStorage::getRegion(const Vec3i chunkCoordinate, const bool create) {
+    const Vec3i regionPos = chunkPosToRegionPos(chunkCoordinate);
+    if (const auto it = regions.find(regionPos); it != regions.end())
+        return it->second.get();
+
+    const std::filesystem::path path = directory / std::format("r.{}.{}.{}.region", regionPos.x, regionPos.y, regionPos.z);
+    if (!create && !std::filesystem::exists(path))
+        return nullptr;
+    if (regions.size() == MAX_OPEN_REGION_FILES)
+        regions.clear();
+    return regions.emplace(regionPos, std::make_unique<RegionFile>(path)).first->second.get();
+}
+
+bool RegionStorage::loadChunk(Chunk &chunk) {
+    const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+    RegionFile* region = getRegion(chunkCoordinate, false);
+    if (!region)
+        return false;
+    const std::optional<std::vector<uint8_t>> data = region->read(chunkCoordinate);
+    if (!data)
+        return false;
+
+    if (!chunk.deserialize(*data)) {
+        Logger::warn(std::format("Saved chunk ({}, {}, {}) is invalid, it will be regenerated",
+            chunkCoordinate.x, chunkCoordinate.y, chunkCoordinate.z));
+        return false;
+    }
+    return true;
+}
+
+void RegionStorage::saveChunk(const Chunk &chunk) {
+    const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+    getRegion(chunkCoordinate, true)->write(chunkCoordinate, chunk.serialize());
+}
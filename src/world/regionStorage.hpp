@@ -0,0 +1,35 @@
+#ifndef VOXELS_REGIONSTORAGE_HPP
+#define VOXELS_REGIONSTORAGE_HPP
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+#include "math/vectors.hpp"
+#include "world/chunk.hpp"
+#include "world/regionFile.hpp"
+
+/**
+ * Saves chunks to the region files of a save directory. Region files are opened on first use
+ * and kept open, up to a limit. They are only created to write chunks, so exploring the world
+ * without saving anything writes nothing. Not thread-safe.
+ */
+class RegionStorage {
+    std::filesystem::path directory;
+    unordered_map<Vec3i, std::unique_ptr<RegionFile>> regions;
+
+    // nullptr when the region's file does not exist and create is false
+    [[nodiscard]] RegionFile* getRegion(Vec3i chunkCoordinate, bool create);
+
+public:
+    // Creates the directory if needed.
+    explicit RegionStorage(std::filesystem::path directory);
+
+    // Replaces the blocks of the chunk with its saved ones. Returns false if it was never saved or its data
+    // is invalid, leaving the chunk filled with air.
+    bool loadChunk(Chunk &chunk);
+    // Writes the chunk to its region file.
+    void saveChunk(const Chunk &chunk);
+};
+
+#endif //VOXELS_REGIONSTORAGE_HPP
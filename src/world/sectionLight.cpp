@@ -0,0 +1,74 @@
+#include "world/sectionLight.hpp"
+
+#include <algorithm>
+
+uint8_t SectionLight::get(const int32_t x, const int32_t y, const int32_t z) const {
+    return get((x * CHUNK_SIZE + z) * SECTION_HEIGHT + y);
+}
+
+uint8_t SectionLight::get(const int32_t index) const {
+    if (!levels)
+        return uniformLight;
+    return (*levels)[index];
+}
+
+void SectionLight::copyColumn(const int32_t x, const int32_t z, const int32_t yMin, const int32_t yMax, uint8_t* out) const {
+    if (!levels) {
+        std::fill(out, out + (yMax - yMin), uniformLight);
+        return;
+    }
+    const uint8_t* column = &(*levels)[(x * CHUNK_SIZE + z) * SECTION_HEIGHT];
+    std::copy(column + yMin, column + yMax, out);
+}
+
+void SectionLight::set(const int32_t index, const uint8_t light) {
+    if (!levels) {
+        if (light == uniformLight)
+            return;
+        levels = std::make_shared<std::array<uint8_t, SECTION_VOLUME>>();
+        levels->fill(uniformLight);
+    } else if (shared) {
+        levels = std::make_shared<std::array<uint8_t, SECTION_VOLUME>>(*levels);
+    }
+    shared = false;
+    (*levels)[index] = light;
+}
+
+void SectionLight::fill(const uint8_t light) {
+    levels = nullptr;
+    uniformLight = light;
+    shared = false;
+}
+
+void SectionLight::assign(const std::span<const uint8_t, SECTION_VOLUME> lights) {
+    if (std::all_of(lights.begin(), lights.end(), [&lights](const uint8_t light) { return light == lights[0]; })) {
+        fill(lights[0]);
+        return;
+    }
+    if (!levels || shared)
+        levels = std::make_shared<std::array<uint8_t, SECTION_VOLUME>>();
+    shared = false;
+    std::copy(lights.begin(), lights.end(), levels->begin());
+}
+
+void SectionLight::compact() {
+    if (levels && std::all_of(levels->begin(), levels->end(), [this](const uint8_t light) { return light == (*levels)[0]; }))
+        fill((*levels)[0]);
+}
+
+SectionLight SectionLight::share() {
+    shared = levels != nullptr;
+    SectionLight copy;
+    copy.levels = levels;
+    copy.uniformLight = uniformLight;
+    copy.shared = shared;
+    return copy;
+}
+
+bool SectionLight::isUniform() const {
+    return !levels;
+}
+
+size_t SectionLight::memoryUsage() const {
+    return sizeof(SectionLight) + (levels ? sizeof(*levels) : 0);
+}
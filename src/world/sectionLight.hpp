@@ -0,0 +1,68 @@
+#ifndef VOXELS_SECTIONLIGHT_HPP
+#define VOXELS_SECTIONLIGHT_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "world/sectionStorage.hpp"
+
+// Light levels range from 0 (dark) to 15, sky light in the high 4 bits of a light value and block light in the low 4
+#define MAX_LIGHT_LEVEL 15
+#define SKY_LIGHT_SHIFT 4
+#define BLOCK_LIGHT_MASK 0x0F
+// Open sky with no block light
+#define FULL_SKY_LIGHT (MAX_LIGHT_LEVEL << SKY_LIGHT_SHIFT)
+
+[[nodiscard]] constexpr uint8_t getSkyLight(const uint8_t light) {
+    return light >> SKY_LIGHT_SHIFT;
+}
+
+[[nodiscard]] constexpr uint8_t getBlockLight(const uint8_t light) {
+    return light & BLOCK_LIGHT_MASK;
+}
+
+/**
+ * Light values of the blocks of a chunk section, in the same order as SectionStorage. Sections lit the
+ * same everywhere, like open sky or solid rock, store a single value.
+ *
+ * The light engine hands the light it computes to chunks with share, both then reading the same values.
+ * The engine's section copies them before changing them again, so each section's light is stored once
+ * while it does not change.
+ */
+class SectionLight {
+    std::shared_ptr<std::array<uint8_t, SECTION_VOLUME>> levels; // nullptr while uniform
+    uint8_t uniformLight = FULL_SKY_LIGHT;
+    bool shared = false; // Whether levels may be read by a copy made with share
+
+public:
+    SectionLight() = default;
+    // Copies are explicit with share
+    SectionLight(const SectionLight&) = delete;
+    SectionLight& operator=(const SectionLight&) = delete;
+    SectionLight(SectionLight&&) = default;
+    SectionLight& operator=(SectionLight&&) = default;
+
+    // Section-relative position, with no bounds checks.
+    [[nodiscard]] uint8_t get(int32_t x, int32_t y, int32_t z) const;
+    // Index in SectionStorage order, with no bounds checks.
+    [[nodiscard]] uint8_t get(int32_t index) const;
+    // Copies the light of the column at x, z with y from yMin (inclusive) to yMax (exclusive) into out.
+    void copyColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, uint8_t* out) const;
+
+    void set(int32_t index, uint8_t light);
+    void fill(uint8_t light);
+    // Replaces every light value, collapsing to a single value when they are all equal.
+    void assign(std::span<const uint8_t, SECTION_VOLUME> lights);
+    // Collapses to a single value when every light value is equal.
+    void compact();
+    // A copy reading the same light values, which are copied before this section changes again. The copy
+    // may be read by another thread while this section changes.
+    [[nodiscard]] SectionLight share();
+
+    [[nodiscard]] bool isUniform() const;
+    [[nodiscard]] size_t memoryUsage() const;
+};
+
+#endif //VOXELS_SECTIONLIGHT_HPP
@@ -0,0 +1,25 @@
+#include "world/sectionSnapshot.hpp"
+
+block_id* SectionSnapshot::column(const int32_t x, const int32_t z) {
+    return blocks[x + 1][z + 1];
+}
+
+const block_id* SectionSnapshot::column(const int32_t x, const int32_t z) const {
+    return blocks[x + 1][z + 1];
+}
+
+block_id SectionSnapshot::getBlock(const Vec3i& pos) const {
+    return blocks[pos.x + 1][pos.z + 1][pos.y + 1];
+}
+
+uint8_t* SectionSnapshot::lightColumn(const int32_t x, const int32_t z) {
+    return lights[x + 1][z + 1];
+}
+
+const uint8_t* SectionSnapshot::lightColumn(const int32_t x, const int32_t z) const {
+    return lights[x + 1][z + 1];
+}
+
+uint8_t SectionSnapshot::getLight(const Vec3i& pos) const {
+    return lights[pos.x + 1][pos.z + 1][pos.y + 1];
+}
@@ -0,0 +1,30 @@
+#ifndef VOXELS_SECTIONSNAPSHOT_HPP
+#define VOXELS_SECTIONSNAPSHOT_HPP
+
+#include "world/chunk.hpp"
+
+/**
+ * Immutable copy of the blocks of a chunk section and their light, surrounded by a one block wide border
+ * copied from the sections above and below and from the adjacent chunks. Meshes are built from snapshots
+ * so they can be built off the render thread while the world keeps changing.
+ */
+class SectionSnapshot {
+    block_id blocks[CHUNK_SIZE + 2][CHUNK_SIZE + 2][SECTION_HEIGHT + 2] {};
+    uint8_t lights[CHUNK_SIZE + 2][CHUNK_SIZE + 2][SECTION_HEIGHT + 2] {};
+
+public:
+    // Column of SECTION_HEIGHT + 2 blocks at the given section-relative position, starting one block below
+    // the section. x and z range from -1 to CHUNK_SIZE.
+    [[nodiscard]] block_id* column(int32_t x, int32_t z);
+    [[nodiscard]] const block_id* column(int32_t x, int32_t z) const;
+
+    // Section-relative position, x and z ranging from -1 to CHUNK_SIZE, y from -1 to SECTION_HEIGHT.
+    [[nodiscard]] block_id getBlock(const Vec3i& pos) const;
+
+    // Light values laid out like the blocks.
+    [[nodiscard]] uint8_t* lightColumn(int32_t x, int32_t z);
+    [[nodiscard]] const uint8_t* lightColumn(int32_t x, int32_t z) const;
+    [[nodiscard]] uint8_t getLight(const Vec3i& pos) const;
+};
+
+#endif //VOXELS_SECTIONSNAPSHOT_HPP
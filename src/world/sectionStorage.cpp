@@ -0,0 +1,336 @@
+#include "world/sectionStorage.hpp"
+
+#include <algorithm>
+
+#include "world/blocks.hpp"
+
+#define DIRECT_BITS_PER_ENTRY 16
+#define MAX_PALETTE_BITS_PER_ENTRY 8
+
+int32_t SectionStorage::indexOf(const int32_t x, const int32_t y, const int32_t z) {
+    return (x * CHUNK_SIZE + z) * SECTION_HEIGHT + y;
+}
+
+uint32_t SectionStorage::getEntry(const int32_t index) const {
+    if (bitsPerEntry == 0)
+        return 0;
+
+    // Entry widths divide 64, so entries never span two words
+    const int32_t bitIndex = index * bitsPerEntry;
+    const uint64_t mask = (1ull << bitsPerEntry) - 1;
+    return static_cast<uint32_t>(data[bitIndex / 64] >> (bitIndex % 64) & mask);
+}
+
+void SectionStorage::setEntry(const int32_t index, const uint32_t entry) {
+    const int32_t bitIndex = index * bitsPerEntry;
+    const uint64_t mask = (1ull << bitsPerEntry) - 1;
+    uint64_t &word = data[bitIndex / 64];
+    word = (word & ~(mask << (bitIndex % 64))) | (static_cast<uint64_t>(entry) << (bitIndex % 64));
+}
+
+block_id SectionStorage::get(const int32_t x, const int32_t y, const int32_t z) const {
+    const uint32_t entry = getEntry(indexOf(x, y, z));
+    return bitsPerEntry == DIRECT_BITS_PER_ENTRY ? static_cast<block_id>(entry) : palette[entry];
+}
+
+void SectionStorage::set(const int32_t x, const int32_t y, const int32_t z, const block_id id) {
+    const int32_t index = indexOf(x, y, z);
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY && palette[getEntry(index)] == id)
+        return;
+
+    replaceEntry(index, entryFor(id));
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY && blockCounts[getEntry(index)] == SECTION_VOLUME)
+        fill(id);
+}
+
+uint32_t SectionStorage::entryFor(const block_id id) {
+    if (bitsPerEntry == DIRECT_BITS_PER_ENTRY)
+        return id;
+
+    if (const auto it = std::find(palette.begin(), palette.end(), id); it != palette.end())
+        return static_cast<uint32_t>(it - palette.begin());
+    // Reuse the entry of a block id no longer present in the section, or add one
+    if (const auto unused = std::find(blockCounts.begin(), blockCounts.end(), 0); unused != blockCounts.end()) {
+        const auto entry = static_cast<uint32_t>(unused - blockCounts.begin());
+        palette[entry] = id;
+        return entry;
+    }
+    if (palette.size() < 1u << bitsPerEntry) {
+        palette.push_back(id);
+        blockCounts.push_back(0);
+        return static_cast<uint32_t>(palette.size() - 1);
+    }
+    repack(id);
+    return entryFor(id);
+}
+
+bool SectionStorage::replaceEntry(const int32_t index, const uint32_t newEntry) {
+    const uint32_t oldEntry = getEntry(index);
+    if (oldEntry == newEntry)
+        return false;
+
+    setEntry(index, newEntry);
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY) {
+        blockCounts[oldEntry]--;
+        blockCounts[newEntry]++;
+    }
+    return true;
+}
+
+void SectionStorage::fill(const block_id id) {
+    // Move-assign fresh vectors so the memory of the previous ones is released
+    palette = std::vector<block_id> { id };
+    blockCounts = std::vector<uint16_t> { SECTION_VOLUME };
+    bitsPerEntry = 0;
+    data = std::vector<uint64_t>();
+}
+
+void SectionStorage::clear() {
+    palette.assign(1, Blocks::AIR.id);
+    blockCounts.assign(1, SECTION_VOLUME);
+    bitsPerEntry = 0;
+    data.clear();
+}
+
+int32_t SectionStorage::fillBox(const Vec3i min, const Vec3i max, const block_id id) {
+    if (min.x == 0 && min.y == 0 && min.z == 0
+            && max.x == CHUNK_SIZE - 1 && max.y == SECTION_HEIGHT - 1 && max.z == CHUNK_SIZE - 1) {
+        int32_t unchanged = 0;
+        if (bitsPerEntry == DIRECT_BITS_PER_ENTRY) {
+            for (int32_t i = 0; i < SECTION_VOLUME; i++) {
+                unchanged += getEntry(i) == id;
+            }
+        } else if (const auto it = std::find(palette.begin(), palette.end(), id); it != palette.end()) {
+            unchanged = blockCounts[it - palette.begin()];
+        }
+        fill(id);
+        return SECTION_VOLUME - unchanged;
+    }
+
+    if (bitsPerEntry == 0 && palette[0] == id)
+        return 0;
+    // The entry is looked up once for the whole box, blocks then only swap entries
+    const uint32_t entry = entryFor(id);
+    int32_t changed = 0;
+    for (int32_t x = min.x; x <= max.x; x++) {
+        for (int32_t z = min.z; z <= max.z; z++) {
+            const int32_t columnIndex = indexOf(x, 0, z);
+            for (int32_t y = min.y; y <= max.y; y++) {
+                changed += replaceEntry(columnIndex + y, entry);
+            }
+        }
+    }
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY && blockCounts[entry] == SECTION_VOLUME)
+        fill(id);
+    return changed;
+}
+
+int32_t SectionStorage::replace(const Vec3i min, const Vec3i max, const block_id from, const block_id to) {
+    if (from == to || !mayContain(from))
+        return 0;
+    if (bitsPerEntry == 0)
+        return fillBox(min, max, to);
+
+    // Adding to can repack the section, the entry of from is only looked up afterwards
+    const uint32_t toEntry = entryFor(to);
+    const uint32_t fromEntry = bitsPerEntry == DIRECT_BITS_PER_ENTRY
+        ? from : static_cast<uint32_t>(std::find(palette.begin(), palette.end(), from) - palette.begin());
+    int32_t changed = 0;
+    for (int32_t x = min.x; x <= max.x; x++) {
+        for (int32_t z = min.z; z <= max.z; z++) {
+            const int32_t columnIndex = indexOf(x, 0, z);
+            for (int32_t y = min.y; y <= max.y; y++) {
+                if (getEntry(columnIndex + y) == fromEntry)
+                    changed += replaceEntry(columnIndex + y, toEntry);
+            }
+        }
+    }
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY && blockCounts[toEntry] == SECTION_VOLUME)
+        fill(to);
+    return changed;
+}
+
+int32_t SectionStorage::pasteColumn(const int32_t x, const int32_t z, const int32_t yMin, const int32_t yMax,
+        const block_id* blocks, const bool skipAir) {
+    int32_t changed = 0;
+    for (int32_t y = yMin; y < yMax; y++) {
+        const block_id id = *blocks++;
+        if ((skipAir && id == Blocks::AIR.id) || get(x, y, z) == id)
+            continue;
+        set(x, y, z, id);
+        changed++;
+    }
+    return changed;
+}
+
+void SectionStorage::repack(const block_id newId) {
+    std::vector<block_id> blocks(SECTION_VOLUME);
+    for (int32_t i = 0; i < SECTION_VOLUME; i++) {
+        blocks[i] = palette[getEntry(i)];
+    }
+
+    std::vector<block_id> newPalette;
+    std::vector<uint16_t> newCounts;
+    for (size_t i = 0; i < palette.size(); i++) {
+        if (blockCounts[i] > 0) {
+            newPalette.push_back(palette[i]);
+            newCounts.push_back(blockCounts[i]);
+        }
+    }
+    newPalette.push_back(newId);
+    newCounts.push_back(0);
+
+    uint8_t newBits = 0;
+    while (newBits <= MAX_PALETTE_BITS_PER_ENTRY && newPalette.size() > 1u << newBits)
+        newBits = newBits == 0 ? 1 : newBits * 2;
+    if (newBits > MAX_PALETTE_BITS_PER_ENTRY)
+        newBits = DIRECT_BITS_PER_ENTRY;
+
+    palette = std::move(newPalette);
+    blockCounts = std::move(newCounts);
+    bitsPerEntry = newBits;
+    data.assign(SECTION_VOLUME * bitsPerEntry / 64, 0);
+
+    for (int32_t i = 0; i < SECTION_VOLUME; i++) {
+        if (bitsPerEntry == DIRECT_BITS_PER_ENTRY) {
+            setEntry(i, blocks[i]);
+        } else {
+            const auto entry = std::find(palette.begin(), palette.end(), blocks[i]) - palette.begin();
+            setEntry(i, static_cast<uint32_t>(entry));
+        }
+    }
+
+    if (bitsPerEntry == DIRECT_BITS_PER_ENTRY) {
+        palette = std::vector<block_id>();
+        blockCounts = std::vector<uint16_t>();
+    }
+}
+
+bool SectionStorage::mayContain(const block_id id) const {
+    if (bitsPerEntry == DIRECT_BITS_PER_ENTRY)
+        return true;
+    for (size_t i = 0; i < palette.size(); i++) {
+        if (palette[i] == id && blockCounts[i] > 0)
+            return true;
+    }
+    return false;
+}
+
+bool SectionStorage::isUniform() const {
+    return bitsPerEntry == 0;
+}
+
+block_id SectionStorage::getUniformBlock() const {
+    return palette[0];
+}
+
+void SectionStorage::copyColumn(const int32_t x, const int32_t z, const int32_t yMin, const int32_t yMax, block_id* out) const {
+    if (bitsPerEntry == 0) {
+        std::fill(out, out + (yMax - yMin), palette[0]);
+        return;
+    }
+
+    const int32_t columnIndex = indexOf(x, 0, z);
+    for (int32_t y = yMin; y < yMax; y++) {
+        const uint32_t entry = getEntry(columnIndex + y);
+        *out++ = bitsPerEntry == DIRECT_BITS_PER_ENTRY ? static_cast<block_id>(entry) : palette[entry];
+    }
+}
+
+size_t SectionStorage::memoryUsage() const {
+    return sizeof(SectionStorage)
+        + palette.capacity() * sizeof(block_id)
+        + blockCounts.capacity() * sizeof(uint16_t)
+        + data.capacity() * sizeof(uint64_t);
+}
+
+void SectionStorage::write(BinaryWriter &writer) const {
+    writer.writeU8(bitsPerEntry);
+    if (bitsPerEntry == 0) {
+        writer.writeVarint(palette[0]);
+        return;
+    }
+    if (bitsPerEntry != DIRECT_BITS_PER_ENTRY) {
+        writer.writeVarint(static_cast<uint32_t>(palette.size()));
+        for (const block_id id : palette) {
+            writer.writeVarint(id);
+        }
+    }
+
+    // Pairs of run length and entry
+    uint32_t runEntry = getEntry(0);
+    uint32_t runLength = 0;
+    for (int32_t i = 0; i < SECTION_VOLUME; i++) {
+        const uint32_t entry = getEntry(i);
+        if (entry != runEntry) {
+            writer.writeVarint(runLength);
+            writer.writeVarint(runEntry);
+            runEntry = entry;
+            runLength = 0;
+        }
+        runLength++;
+    }
+    writer.writeVarint(runLength);
+    writer.writeVarint(runEntry);
+}
+
+bool SectionStorage::read(BinaryReader &reader) {
+    const auto invalid = [this, &reader] {
+        reader.fail();
+        fill(Blocks::AIR.id);
+        return false;
+    };
+
+    const uint8_t bits = reader.readU8();
+    if (bits == 0) {
+        const uint32_t id = reader.readVarint();
+        if (reader.hasFailed() || id >= BLOCK_COUNT)
+            return invalid();
+        fill(static_cast<block_id>(id));
+        return true;
+    }
+    if (bits != 1 && bits != 2 && bits != 4 && bits != 8 && bits != DIRECT_BITS_PER_ENTRY)
+        return invalid();
+
+    std::vector<block_id> newPalette;
+    if (bits != DIRECT_BITS_PER_ENTRY) {
+        const uint32_t paletteSize = reader.readVarint();
+        if (paletteSize == 0 || paletteSize > 1u << bits)
+            return invalid();
+        for (uint32_t i = 0; i < paletteSize; i++) {
+            const uint32_t id = reader.readVarint();
+            if (id >= BLOCK_COUNT)
+                return invalid();
+            newPalette.push_back(static_cast<block_id>(id));
+        }
+    }
+
+    palette = std::move(newPalette);
+    blockCounts.assign(palette.size(), 0);
+    bitsPerEntry = bits;
+    data.assign(SECTION_VOLUME * bitsPerEntry / 64, 0);
+
+    // Direct entries are block ids
+    const uint32_t entryLimit = bits == DIRECT_BITS_PER_ENTRY ? BLOCK_COUNT : static_cast<uint32_t>(palette.size());
+    int32_t index = 0;
+    while (index < SECTION_VOLUME) {
+        const uint32_t runLength = reader.readVarint();
+        const uint32_t entry = reader.readVarint();
+        if (reader.hasFailed() || runLength == 0 || runLength > static_cast<uint32_t>(SECTION_VOLUME - index)
+                || entry >= entryLimit)
+            return invalid();
+
+        if (bits != DIRECT_BITS_PER_ENTRY)
+            blockCounts[entry] += runLength;
+        for (uint32_t i = 0; i < runLength; i++) {
+            setEntry(index++, entry);
+        }
+    }
+
+    // Sections saved with an entry per block may hold a single block id
+    for (size_t i = 0; i < blockCounts.size(); i++) {
+        if (blockCounts[i] == SECTION_VOLUME)
+            fill(palette[i]);
+    }
+    return true;
+}
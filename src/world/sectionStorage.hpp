@@ -0,0 +1,75 @@
+#ifndef VOXELS_SECTIONSTORAGE_HPP
+#define VOXELS_SECTIONSTORAGE_HPP
+
+#include <vector>
+
+#include "world/binaryStream.hpp"
+#include "world/block.hpp"
+#include "world/chunkDimensions.hpp"
+#include "math/vectors.hpp"
+
+#define SECTION_VOLUME (CHUNK_SIZE * CHUNK_SIZE * SECTION_HEIGHT)
+
+/**
+ * Palette-compressed storage of the blocks of a chunk section. Each block is stored as an index
+ * into a palette of the block ids present in the section, bit-packed into 64-bit words. Entries
+ * widen automatically (0, 1, 2, 4 then 8 bits) as new block ids are written. Past 256 distinct
+ * ids, block ids are stored directly on 16 bits and the palette is dropped.
+ *
+ * A section filled with a single block id is uniform: it stores only that id, and is detected as
+ * soon as the last differing block is overwritten (except in direct storage).
+ */
+class SectionStorage {
+    std::vector<block_id> palette { 0 };
+    std::vector<uint16_t> blockCounts { SECTION_VOLUME }; // Number of blocks using each palette entry
+    std::vector<uint64_t> data; // Empty while the section is uniform
+    uint8_t bitsPerEntry = 0;
+
+    [[nodiscard]] static int32_t indexOf(int32_t x, int32_t y, int32_t z);
+    [[nodiscard]] uint32_t getEntry(int32_t index) const;
+    void setEntry(int32_t index, uint32_t entry);
+    // Drops unused palette entries, adds newId, and re-encodes the data with the smallest sufficient width.
+    void repack(block_id newId);
+    // The entry of id, added to the palette if missing, in place of an unused one or by repacking when full.
+    // In direct storage, id itself.
+    uint32_t entryFor(block_id id);
+    // Sets the entry at index to newEntry, keeping the block counts, and reports whether the block changed.
+    bool replaceEntry(int32_t index, uint32_t newEntry);
+
+public:
+    // Section-relative position, with no bounds checks.
+    [[nodiscard]] block_id get(int32_t x, int32_t y, int32_t z) const;
+    void set(int32_t x, int32_t y, int32_t z, block_id id);
+    // Sets every block of the section to id, making it uniform.
+    void fill(block_id id);
+    // Fills the section with air like fill, but keeps the allocated memory to reuse it.
+    void clear();
+    // Sets the blocks between min and max, both inclusive and section-relative, to id. Returns the number
+    // of blocks changed. Covering the whole section fills it without touching blocks one by one.
+    int32_t fillBox(Vec3i min, Vec3i max, block_id id);
+    // Replaces the blocks equal to from between min and max, both inclusive, with to. Returns the number of
+    // blocks changed. Sections without from are skipped without reading their blocks.
+    int32_t replace(Vec3i min, Vec3i max, block_id from, block_id to);
+    // Copies blocks from the column at x, z with y from yMin (inclusive) to yMax (exclusive), the reverse
+    // of copyColumn. Air is left out when skipAir is set. Returns the number of blocks changed.
+    int32_t pasteColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, const block_id* blocks, bool skipAir);
+
+    // Whether some block of the section may be id. Always true in direct storage, which keeps no palette.
+    [[nodiscard]] bool mayContain(block_id id) const;
+    [[nodiscard]] bool isUniform() const;
+    // The block filling the section, only meaningful when it is uniform.
+    [[nodiscard]] block_id getUniformBlock() const;
+
+    // Copies the blocks of the column at x, z with y from yMin (inclusive) to yMax (exclusive) into out.
+    void copyColumn(int32_t x, int32_t z, int32_t yMin, int32_t yMax, block_id* out) const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+    // Writes the palette and the run-length encoded entries, in storage order so runs follow columns.
+    void write(BinaryWriter &writer) const;
+    // Reads what write wrote. Returns false on malformed data or unknown block ids, leaving the section
+    // filled with air.
+    bool read(BinaryReader &reader);
+};
+
+#endif //VOXELS_SECTIONSTORAGE_HPP
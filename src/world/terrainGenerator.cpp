@@ -0,0 +1,257 @@
+#include "world/terrainGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+
+#include "world/blocks.hpp"
+#include "world/noise.hpp"
+
+// Spacing in blocks of the coarse grid on which noise is evaluated
+#define GENERATION_CELL_WIDTH 4
+#define GENERATION_CELL_HEIGHT 8
+#define GRID_WIDTH (CHUNK_SIZE / GENERATION_CELL_WIDTH + 1)
+#define GRID_HEIGHT (CHUNK_HEIGHT / GENERATION_CELL_HEIGHT + 1)
+
+// Terrain shape, in blocks
+#define BASE_HEIGHT 24.0f
+#define HEIGHT_VARIATION 14.0f
+// Height difference over which the density goes from 0 to 1, the larger the more overhangs
+#define DENSITY_FALLOFF 8.0f
+#define DENSITY_NOISE_AMPLITUDE 4.0f
+// Lowest and highest heights the density can be positive at, the noise being roughly in [-1, 1]. The margin
+// of a grid cell covers the noise going slightly past 1.
+#define MIN_TERRAIN_SURFACE (BASE_HEIGHT - HEIGHT_VARIATION - DENSITY_NOISE_AMPLITUDE * DENSITY_FALLOFF - GENERATION_CELL_HEIGHT)
+#define MAX_TERRAIN_HEIGHT (BASE_HEIGHT + HEIGHT_VARIATION + DENSITY_NOISE_AMPLITUDE * DENSITY_FALLOFF + GENERATION_CELL_HEIGHT)
+
+// Features per chunk: columns tried for a tree, and the chance of a boulder as 1 in BOULDER_RARITY
+#define TREE_ATTEMPTS 4
+#define TREE_MIN_HEIGHT 4
+#define TREE_MAX_HEIGHT 6
+#define BOULDER_RARITY 6
+#define BOULDER_MAX_RADIUS 2
+// Highest block of a tree above the grass it grows on
+#define MAX_FEATURE_HEIGHT (TREE_MAX_HEIGHT + 1)
+
+#define FLAT_GRASS_HEIGHT 10
+
+// Density of the terrain at the points of a chunk's coarse grid, indexed by [x][z][y], solid where positive
+using DensityGrid = std::array<float, GRID_WIDTH * GRID_WIDTH * GRID_HEIGHT>;
+// Densities of a column of grid points interpolated between the four around a column of blocks
+using ColumnDensities = std::array<float, GRID_HEIGHT>;
+
+HeightMap TerrainGenerator::getSkyHeights(Vec2i) const {
+    HeightMap heights;
+    heights.fill(getMaxHeight());
+    return heights;
+}
+
+void FlatTerrainGenerator::generate(Chunk &chunk, const Vec3i chunkCoordinate) const {
+    const int32_t originY = chunkPosToBlockPos(chunkCoordinate).y;
+    const int32_t grassY = FLAT_GRASS_HEIGHT - originY;
+    if (grassY >= 0) {
+        const int32_t top = std::min(grassY, CHUNK_HEIGHT);
+        chunk.fillBox({0, 0, 0}, {CHUNK_SIZE - 1, top - 1, CHUNK_SIZE - 1}, Blocks::STONE.id);
+    }
+    if (grassY >= 0 && grassY < CHUNK_HEIGHT)
+        chunk.fillBox({0, grassY, 0}, {CHUNK_SIZE - 1, grassY, CHUNK_SIZE - 1}, Blocks::GRASS.id);
+
+    const int32_t testY = grassY + 1;
+    if (testY >= 0 && testY < CHUNK_HEIGHT) {
+        chunk.setBlock({0, testY, 0}, Blocks::TEST);
+        chunk.setBlock({CHUNK_SIZE - 1, testY, 0}, Blocks::TEST);
+        chunk.setBlock({0, testY, CHUNK_SIZE - 1}, Blocks::TEST);
+        chunk.setBlock({CHUNK_SIZE - 1, testY, CHUNK_SIZE - 1}, Blocks::TEST);
+    }
+}
+
+int32_t FlatTerrainGenerator::getMaxHeight() const {
+    return FLAT_GRASS_HEIGHT + 2;
+}
+
+HeightMap FlatTerrainGenerator::getSkyHeights(Vec2i) const {
+    HeightMap heights;
+    heights.fill(FLAT_GRASS_HEIGHT + 1);
+    // TEST blocks on the corners
+    for (const int32_t x : {0, CHUNK_SIZE - 1}) {
+        for (const int32_t z : {0, CHUNK_SIZE - 1}) {
+            heights[x * CHUNK_SIZE + z] = FLAT_GRASS_HEIGHT + 2;
+        }
+    }
+    return heights;
+}
+
+NoiseTerrainGenerator::NoiseTerrainGenerator(const uint32_t seed): seed(seed) {}
+
+int32_t NoiseTerrainGenerator::getMaxHeight() const {
+    return static_cast<int32_t>(std::ceil(MAX_TERRAIN_HEIGHT)) + MAX_FEATURE_HEIGHT;
+}
+
+// Height in the chunk of the highest grass block of a column
+std::optional<int32_t> findGrass(const Chunk &chunk, const int32_t x, const int32_t z) {
+    for (int32_t y = CHUNK_HEIGHT - 1; y >= 0; y--) {
+        if (chunk.getBlockUnchecked(x, y, z) == Blocks::GRASS.id)
+            return y;
+    }
+    return std::nullopt;
+}
+
+void NoiseTerrainGenerator::placeFeatures(const Chunk &chunk, const Vec3i chunkCoordinate,
+        std::vector<FeatureBlock> &blocks) const {
+    // Seeded by the chunk alone, so features do not depend on the order chunks are generated in
+    std::mt19937 random(seed ^ static_cast<uint32_t>(std::hash<Vec3i>()(chunkCoordinate)));
+    const Vec3i origin = chunk.getOrigin();
+
+    // Canopies and boulders near the chunk's edges reach into the adjacent chunks
+    for (int32_t attempt = 0; attempt < TREE_ATTEMPTS; attempt++) {
+        const auto x = static_cast<int32_t>(random() % CHUNK_SIZE);
+        const auto z = static_cast<int32_t>(random() % CHUNK_SIZE);
+        const auto height = static_cast<int32_t>(TREE_MIN_HEIGHT + random() % (TREE_MAX_HEIGHT - TREE_MIN_HEIGHT + 1));
+        if (const std::optional<int32_t> y = findGrass(chunk, x, z))
+            Features::placeTree(blocks, { origin.x + x, origin.y + *y + 1, origin.z + z }, height);
+    }
+
+    const bool boulder = random() % BOULDER_RARITY == 0;
+    const auto x = static_cast<int32_t>(random() % CHUNK_SIZE);
+    const auto z = static_cast<int32_t>(random() % CHUNK_SIZE);
+    const auto radius = static_cast<int32_t>(1 + random() % BOULDER_MAX_RADIUS);
+    if (const std::optional<int32_t> y = findGrass(chunk, x, z); boulder && y)
+        Features::placeBoulder(blocks, { origin.x + x, origin.y + *y + radius - 1, origin.z + z }, radius);
+}
+
+void sampleDensities(const uint32_t seed, const Vec3i origin, DensityGrid &densities) {
+    const FractalNoise heightNoise { seed, 4, 1.0f / 128.0f };
+    const FractalNoise densityNoise { seed + 1000, 3, 1.0f / 32.0f };
+    const auto originX = static_cast<float>(origin.x);
+    const auto originY = static_cast<float>(origin.y);
+    const auto originZ = static_cast<float>(origin.z);
+
+    // The height map only uses the y = 0 layer of the grid points
+    constexpr size_t gridSize = GRID_WIDTH * GRID_WIDTH * GRID_HEIGHT;
+    std::array<float, gridSize> xs {}, ys {}, zs {};
+    std::array<float, GRID_WIDTH * GRID_WIDTH> heights {};
+    for (int gx = 0; gx < GRID_WIDTH; gx++) {
+        for (int gz = 0; gz < GRID_WIDTH; gz++) {
+            for (int gy = 0; gy < GRID_HEIGHT; gy++) {
+                const size_t index = (gx * GRID_WIDTH + gz) * GRID_HEIGHT + gy;
+                xs[index] = originX + static_cast<float>(gx * GENERATION_CELL_WIDTH);
+                ys[index] = originY + static_cast<float>(gy * GENERATION_CELL_HEIGHT);
+                zs[index] = originZ + static_cast<float>(gz * GENERATION_CELL_WIDTH);
+            }
+        }
+    }
+
+    // The height map is sampled in the plane y = 0.5, away from the noise lattice
+    std::array<float, GRID_WIDTH * GRID_WIDTH> columnXs {}, columnYs {}, columnZs {};
+    for (int column = 0; column < GRID_WIDTH * GRID_WIDTH; column++) {
+        columnXs[column] = xs[column * GRID_HEIGHT];
+        columnYs[column] = 0.5f;
+        columnZs[column] = zs[column * GRID_HEIGHT];
+    }
+    Noise::fractal3D(heightNoise, columnXs.data(), columnYs.data(), columnZs.data(), heights.data(), heights.size());
+    Noise::fractal3D(densityNoise, xs.data(), ys.data(), zs.data(), densities.data(), gridSize);
+
+    for (size_t index = 0; index < gridSize; index++) {
+        const float height = BASE_HEIGHT + heights[index / GRID_HEIGHT] * HEIGHT_VARIATION;
+        densities[index] = densities[index] * DENSITY_NOISE_AMPLITUDE + (height - ys[index]) / DENSITY_FALLOFF;
+    }
+}
+
+// Bilinear part of the trilinear interpolation of the density, for the column of blocks at x, z of the chunk
+void interpolateColumn(const DensityGrid &densities, const int x, const int z, ColumnDensities &column) {
+    const int gx = x / GENERATION_CELL_WIDTH;
+    const float tx = static_cast<float>(x % GENERATION_CELL_WIDTH) / GENERATION_CELL_WIDTH;
+    const int gz = z / GENERATION_CELL_WIDTH;
+    const float tz = static_cast<float>(z % GENERATION_CELL_WIDTH) / GENERATION_CELL_WIDTH;
+
+    const float* d00 = &densities[(gx * GRID_WIDTH + gz) * GRID_HEIGHT];
+    const float* d10 = &densities[((gx + 1) * GRID_WIDTH + gz) * GRID_HEIGHT];
+    const float* d01 = &densities[(gx * GRID_WIDTH + gz + 1) * GRID_HEIGHT];
+    const float* d11 = &densities[((gx + 1) * GRID_WIDTH + gz + 1) * GRID_HEIGHT];
+    for (int gy = 0; gy < GRID_HEIGHT; gy++) {
+        const float near = d00[gy] + (d10[gy] - d00[gy]) * tx;
+        const float far = d01[gy] + (d11[gy] - d01[gy]) * tx;
+        column[gy] = near + (far - near) * tz;
+    }
+}
+
+bool isSolid(const ColumnDensities &column, const int y) {
+    const int gy = y / GENERATION_CELL_HEIGHT;
+    const float ty = static_cast<float>(y % GENERATION_CELL_HEIGHT) / GENERATION_CELL_HEIGHT;
+    return column[gy] + (column[gy + 1] - column[gy]) * ty > 0.0f;
+}
+
+void NoiseTerrainGenerator::generate(Chunk &chunk, const Vec3i chunkCoordinate) const {
+    // Chunks above the terrain stay air, chunks deep below it are solid stone
+    const Vec3i origin = chunkPosToBlockPos(chunkCoordinate);
+    const int32_t top = std::min(CHUNK_HEIGHT, static_cast<int32_t>(std::ceil(MAX_TERRAIN_HEIGHT)) - origin.y);
+    if (top <= 0)
+        return;
+    if (static_cast<float>(origin.y + CHUNK_HEIGHT) < MIN_TERRAIN_SURFACE) {
+        chunk.fillBox({0, 0, 0}, {CHUNK_SIZE - 1, CHUNK_HEIGHT - 1, CHUNK_SIZE - 1}, Blocks::STONE.id);
+        return;
+    }
+
+    DensityGrid densities;
+    sampleDensities(seed, origin, densities);
+
+    // Trilinear interpolation of the density, each column being filled from the top so the
+    // first solid block under air becomes grass.
+    ColumnDensities columnDensities;
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            interpolateColumn(densities, x, z, columnDensities);
+
+            // The block above the chunk is air when its density, the top grid point, is not positive
+            bool airAbove = top < CHUNK_HEIGHT || columnDensities[GRID_HEIGHT - 1] <= 0.0f;
+            for (int y = top - 1; y >= 0; y--) {
+                const bool solid = isSolid(columnDensities, y);
+                if (solid)
+                    chunk.setBlock({x, y, z}, airAbove ? Blocks::GRASS : Blocks::STONE);
+                airAbove = !solid;
+            }
+        }
+    }
+}
+
+HeightMap NoiseTerrainGenerator::getSkyHeights(const Vec2i chunkColumn) const {
+    // Chunks are searched from the top of the terrain down, like generate fills them, until every column has
+    // met a solid block
+    constexpr int32_t unknown = std::numeric_limits<int32_t>::min();
+    HeightMap heights;
+    heights.fill(unknown);
+    int32_t remaining = CHUNK_SIZE * CHUNK_SIZE;
+
+    const auto maxHeight = static_cast<int32_t>(std::ceil(MAX_TERRAIN_HEIGHT));
+    DensityGrid densities;
+    ColumnDensities columnDensities;
+    for (int32_t chunkY = blockPosToChunkPos({0, maxHeight - 1, 0}).y; remaining > 0; chunkY--) {
+        const Vec3i origin = chunkPosToBlockPos({chunkColumn.x, chunkY, chunkColumn.y});
+        if (static_cast<float>(origin.y + CHUNK_HEIGHT) < MIN_TERRAIN_SURFACE) {
+            std::replace(heights.begin(), heights.end(), unknown, origin.y + CHUNK_HEIGHT);
+            break;
+        }
+
+        sampleDensities(seed, origin, densities);
+        const int32_t top = std::min(CHUNK_HEIGHT, maxHeight - origin.y);
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                int32_t &height = heights[x * CHUNK_SIZE + z];
+                if (height != unknown)
+                    continue;
+                interpolateColumn(densities, x, z, columnDensities);
+                for (int y = top - 1; y >= 0; y--) {
+                    if (isSolid(columnDensities, y)) {
+                        height = origin.y + y + 1;
+                        remaining--;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return heights;
+}
@@ -0,0 +1,56 @@
+#ifndef VOXELS_TERRAINGENERATOR_HPP
+#define VOXELS_TERRAINGENERATOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/chunk.hpp"
+#include "world/features.hpp"
+
+// Value per column of a chunk column, indexed by x then z like the columns of SectionStorage.
+using HeightMap = std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE>;
+
+// Fills newly loaded chunks. Generation must be deterministic: a chunk coordinate always gives the same blocks.
+// Both stages may run on several threads at once, for different chunks.
+class TerrainGenerator {
+public:
+    virtual ~TerrainGenerator() = default;
+    // Fills a chunk which only contains air.
+    virtual void generate(Chunk &chunk, Vec3i chunkCoordinate) const = 0;
+    // Adds the features rooted in a chunk once its terrain is generated, chosen from that terrain alone.
+    virtual void placeFeatures(const Chunk &, Vec3i, std::vector<FeatureBlock> &) const {}
+    // World height from which generated blocks are all air, so chunks above it are open to the sky.
+    [[nodiscard]] virtual int32_t getMaxHeight() const = 0;
+    // World height above the highest opaque block of each column of the chunk column at x, z, sky light coming
+    // down to it. getMaxHeight everywhere unless overridden.
+    [[nodiscard]] virtual HeightMap getSkyHeights(Vec2i chunkColumn) const;
+};
+
+// Stone up to a grass top at y = 10, with a TEST block on each corner of every chunk.
+class FlatTerrainGenerator : public TerrainGenerator {
+public:
+    void generate(Chunk &chunk, Vec3i chunkCoordinate) const override;
+    [[nodiscard]] int32_t getMaxHeight() const override;
+    [[nodiscard]] HeightMap getSkyHeights(Vec2i chunkColumn) const override;
+};
+
+/**
+ * Hills from fractal noise: a height map shapes the terrain, and 3D noise added to the density
+ * makes overhangs. Noise is evaluated on a coarse grid and interpolated for each block. Trees and
+ * the odd boulder grow on grass.
+ */
+class NoiseTerrainGenerator : public TerrainGenerator {
+    uint32_t seed;
+
+public:
+    explicit NoiseTerrainGenerator(uint32_t seed);
+    void generate(Chunk &chunk, Vec3i chunkCoordinate) const override;
+    void placeFeatures(const Chunk &chunk, Vec3i chunkCoordinate, std::vector<FeatureBlock> &blocks) const override;
+    [[nodiscard]] int32_t getMaxHeight() const override;
+    // Heights of the terrain alone, features like trees being placed later from the generated chunks.
+    [[nodiscard]] HeightMap getSkyHeights(Vec2i chunkColumn) const override;
+};
+
+#endif //VOXELS_TERRAINGENERATOR_HPP
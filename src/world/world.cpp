@@ -1,153 +1,418 @@
 #include "world/world.hpp"
 
+#include <algorithm>
+#include <utility>
+
+#include "world/blockAccessor.hpp"
 #include "logger.hpp"
 
-World::World() {
-    // Setting up shaders
-    chunkShader.use();
-    chunkShader.setIntUniform("atlas", 0);
-    highlightShader.use();
-    highlightShader.setVec4Uniform("highlightColor", 1.0f, 0.7f, 0.0f, 0.25f);
-
-    // Setting up VAO for the highlight cube
-    constexpr float cubeVertices[] = {
-        // Front face
-        0, 0, 1, 0, 0,
-        1, 0, 1, 1, 0,
-        0, 1, 1, 0, 1,
-        0, 1, 1, 0, 1,
-        1, 0, 1, 1, 0,
-        1, 1, 1, 1, 1,
-        // Back face
-        1, 0, 0, 0, 0,
-        0, 0, 0, 1, 0,
-        1, 1, 0, 0, 1,
-        1, 1, 0, 0, 1,
-        0, 0, 0, 1, 0,
-        0, 1, 0, 1, 1,
-        // Right face,
-        1, 0, 1, 0, 0,
-        1, 0, 0, 1, 0,
-        1, 1, 1, 0, 1,
-        1, 1, 1, 0, 1,
-        1, 0, 0, 1, 0,
-        1, 1, 0, 1, 1,
-        // Left face
-        0, 0, 0, 0, 0,
-        0, 0, 1, 1, 0,
-        0, 1, 0, 0, 1,
-        0, 1, 0, 0, 1,
-        0, 0, 1, 1, 0,
-        0, 1, 1, 1, 1,
-        // Top face
-        0, 1, 1, 0, 0,
-        1, 1, 1, 1, 0,
-        0, 1, 0, 0, 1,
-        0, 1, 0, 0, 1,
-        1, 1, 1, 1, 0,
-        1, 1, 0, 1, 1,
-        // Bottom face,
-        0, 0, 0, 0, 0,
-        1, 0, 0, 1, 0,
-        0, 0, 1, 0, 1,
-        0, 0, 1, 0, 1,
-        1, 0, 0, 1, 0,
-        1, 0, 1, 1, 1,
+#define RAYCAST_MAX_STEPS 100
+// Chunks taken from storage or from the generation pipeline per call to updateLoadedChunks, spreading the work
+// over several ticks
+#define MAX_CHUNK_LOADS_PER_UPDATE 16
+// Mesh jobs queued or running at once, so newly outdated nearby sections do not wait behind far away ones
+#define MAX_PENDING_MESH_JOBS 32
+
+struct NeighborSide {
+    BlockFace side;
+    BlockFace opposite;
+    int32_t dx;
+    int32_t dy;
+    int32_t dz;
+};
+
+constexpr NeighborSide NEIGHBOR_SIDES[] = {
+    { BlockFace::NORTH, BlockFace::SOUTH, 0, 0, -1 },
+    { BlockFace::SOUTH, BlockFace::NORTH, 0, 0, 1 },
+    { BlockFace::EAST, BlockFace::WEST, 1, 0, 0 },
+    { BlockFace::WEST, BlockFace::EAST, -1, 0, 0 },
+    { BlockFace::UP, BlockFace::DOWN, 0, 1, 0 },
+    { BlockFace::DOWN, BlockFace::UP, 0, -1, 0 },
+};
+
+// Whether a chunk at the given offset is within a cylinder of radius distance + 0.5 chunks
+// and verticalDistance chunks above and below
+bool isWithinDistance(const Vec3i offset, const int32_t distance, const int32_t verticalDistance) {
+    return offset.x * offset.x + offset.z * offset.z <= distance * distance + distance
+        && std::abs(offset.y) <= verticalDistance;
+}
+
+int32_t squaredDistance(const Vec3i a, const Vec3i b) {
+    const int32_t dx = a.x - b.x;
+    const int32_t dy = a.y - b.y;
+    const int32_t dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+World::World(std::unique_ptr<TerrainGenerator> generator, std::unique_ptr<RegionStorage> storage, const int32_t renderDistance):
+    generator(std::move(generator)), generation(*this->generator) {
+    if (storage)
+        saveWorker = std::make_unique<ChunkSaveWorker>(std::move(storage));
+    setRenderDistance(renderDistance);
+}
+
+int32_t World::getRenderDistance() const {
+    return renderDistance;
+}
+
+void World::setRenderDistance(const int32_t distance) {
+    renderDistance = distance;
+
+    loadOrder.clear();
+    for (int32_t x = -distance; x <= distance; x++) {
+        for (int32_t y = -VERTICAL_RENDER_DISTANCE; y <= VERTICAL_RENDER_DISTANCE; y++) {
+            for (int32_t z = -distance; z <= distance; z++) {
+                if (isWithinDistance({x, y, z}, distance, VERTICAL_RENDER_DISTANCE))
+                    loadOrder.emplace_back(x, y, z);
+            }
+        }
+    }
+    std::stable_sort(loadOrder.begin(), loadOrder.end(), [](const Vec3i a, const Vec3i b) {
+        return squaredDistance(a, {0, 0, 0}) < squaredDistance(b, {0, 0, 0});
+    });
+}
+
+bool World::updateLoadedChunks(const Vec3i center) {
+    streamingCenter = center;
+
+    // Chunks are kept one chunk further than they are loaded, so going back and forth
+    // across a chunk border does not unload and reload them.
+    std::vector<Vec3i> outOfRange;
+    for (const Chunk &chunk : chunks) {
+        const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+        const Vec3i offset(chunkCoordinate.x - center.x, chunkCoordinate.y - center.y, chunkCoordinate.z - center.z);
+        if (!isWithinDistance(offset, renderDistance + 1, VERTICAL_RENDER_DISTANCE + 1))
+            outOfRange.push_back(chunkCoordinate);
+    }
+    for (const Vec3i &chunkCoordinate : outOfRange) {
+        Chunk* chunk = chunks.remove(chunkCoordinate);
+        unlinkNeighbors(*chunk);
+        if (saveWorker && chunk->hasUnsavedChanges())
+            saveWorker->save(*chunk);
+        chunks.recycle(chunk);
+        lightWorker.unloadChunk(chunkCoordinate);
+        editedChunks.erase(chunkCoordinate);
+        unloadedChunks.push_back(chunkCoordinate);
+    }
+
+    // Features and reads of chunks just out of range are kept, chunks coming back in range often need them
+    const auto far = [&](const Vec3i chunkCoordinate) {
+        const Vec3i offset(chunkCoordinate.x - center.x, chunkCoordinate.y - center.y, chunkCoordinate.z - center.z);
+        return !isWithinDistance(offset, renderDistance + 1 + FEATURE_REACH_CHUNKS,
+            VERTICAL_RENDER_DISTANCE + 1 + FEATURE_REACH_CHUNKS);
     };
+    generation.discard(far);
+    generation.discardSkyHeights([&](const Vec2i chunkColumn) { return far({chunkColumn.x, center.y, chunkColumn.y}); });
+    generation.collectResults();
+    if (saveWorker) {
+        saveWorker->discard(far);
+        saveWorker->collectLoads();
+    }
 
-    glGenVertexArrays(1, &cubeVAO);
-    glBindVertexArray(cubeVAO);
+    int32_t loads = 0;
+    bool allLoaded = true;
+    for (const Vec3i &offset : loadOrder) {
+        const Vec3i chunkCoordinate(center.x + offset.x, center.y + offset.y, center.z + offset.z);
+        if (chunkCoordinate.y < WORLD_MIN_CHUNK_Y || chunkCoordinate.y > WORLD_MAX_CHUNK_Y
+                || chunks.contains(chunkCoordinate))
+            continue;
+        if (loads == MAX_CHUNK_LOADS_PER_UPDATE)
+            return false;
+        // Needed to light the chunk, whether it is saved or generated
+        const HeightMap* skyHeights = generation.requestSkyHeights({chunkCoordinate.x, chunkCoordinate.z});
+        if (!skyHeights) {
+            allLoaded = false;
+            continue;
+        }
 
-    GLuint VBO;
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+        // Saved chunks are loaded as they were, features included. Storage is only read before the chunk is
+        // requested from the generation pipeline.
+        bool loaded = false;
+        if (saveWorker && !generation.isRequested(chunkCoordinate)) {
+            const ChunkLoadStatus status = saveWorker->load(chunkCoordinate);
+            if (status == ChunkLoadStatus::PENDING) {
+                allLoaded = false;
+                continue;
+            }
+            if (status == ChunkLoadStatus::LOADED) {
+                saveWorker->take(chunkCoordinate, chunks.insert(chunkCoordinate));
+                loaded = true;
+            }
+        }
+        if (!loaded) {
+            if (!generation.request(chunkCoordinate)) {
+                allLoaded = false;
+                continue;
+            }
+            generation.take(chunkCoordinate, chunks.insert(chunkCoordinate));
+        }
+        loads++;
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-        reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+        Chunk &chunk = *chunks.find(chunkCoordinate);
+        linkNeighbors(chunk);
+        // Sky light comes down the columns the terrain above does not cover while the chunk above is not loaded
+        SkyColumns openSky;
+        const int32_t top = chunk.getOrigin().y + CHUNK_HEIGHT;
+        for (int32_t column = 0; column < CHUNK_SIZE * CHUNK_SIZE; column++) {
+            openSky[column] = (*skyHeights)[column] <= top;
+        }
+        const uint64_t lightLoad = nextLightLoadId++;
+        chunk.setLightLoad(lightLoad);
+        lightWorker.loadChunk(chunk.copyBlocks(), openSky, lightLoad);
+    }
+    return allLoaded;
+}
+
+int32_t World::autosave() {
+    if (!saveWorker)
+        return 0;
 
-    // Instantiating chunks
-    for (int32_t x = -1; x < 2; x++) {
-        for (int32_t z = -1; z < 2; z++) {
-            Vec2i chunkCoordinate { x, z };
-            Chunk chunk(chunkCoordinate);
-            chunks.insert({ chunkCoordinate, chunk });
+    int32_t saved = 0;
+    for (const Vec3i &chunkCoordinate : editedChunks) {
+        Chunk &chunk = *chunks.find(chunkCoordinate);
+        if (chunk.hasUnsavedChanges()) {
+            saveWorker->save(chunk);
+            chunk.markSaved();
+            saved++;
         }
     }
+    editedChunks.clear();
+    return saved;
 }
 
-void World::draw(const Camera &camera, const Atlas &atlas) {
-    const glm::mat4 projection = camera.getProjectionMatrix();
-    const glm::mat4 view = camera.getViewMatrix();
+int32_t World::saveChunks() {
+    if (!saveWorker)
+        return 0;
 
-    // Chunk rendering
-    chunkShader.use();
-    chunkShader.setMatrix4fUniform("projection", projection);
-    chunkShader.setMatrix4fUniform("view", view);
+    int32_t saved = 0;
+    for (Chunk &chunk : chunks) {
+        if (chunk.hasUnsavedChanges()) {
+            saveWorker->save(chunk);
+            chunk.markSaved();
+            saved++;
+        }
+    }
+    editedChunks.clear();
+    return saved;
+}
 
-    for (auto &[pos, chunk] : chunks) {
-        chunk.draw(chunkShader, atlas);
+std::vector<Vec3i> World::collectUnloadedChunks() {
+    return std::exchange(unloadedChunks, {});
+}
+
+void World::applyLightUpdates() {
+    for (LightUpdate &update : lightWorker.collectUpdates()) {
+        // Updates queued before the chunk was unloaded are outdated, even once it is loaded again
+        Chunk* chunk = findChunk(update.chunkCoordinate);
+        if (!chunk || chunk->getLightLoad() != update.loadId)
+            continue;
+        chunk->setSectionLight(update.section, std::move(update.light));
+        if (update.chunkLoaded) {
+            chunk->markLightReady();
+            // The chunk's blocks occlude the corners of faces of the chunks along its edges and corners too
+            const int32_t sectionY = update.section * SECTION_HEIGHT;
+            markBorderSectionsDirty(update.chunkCoordinate, {0, sectionY, 0},
+                {CHUNK_SIZE - 1, sectionY + SECTION_HEIGHT - 1, CHUNK_SIZE - 1});
+        }
+
+        // Faces are lit by the block in front of them, which may be in an adjacent section
+        const Vec3i pos = update.chunkCoordinate;
+        const int32_t section = update.section;
+        const auto changed = [&update](const BlockFace face) { return update.changedBorders & 1 << static_cast<int>(face); };
+        chunk->markSectionMeshDirty(section);
+        if (changed(BlockFace::DOWN)) {
+            if (section > 0)
+                chunk->markSectionMeshDirty(section - 1);
+            else
+                markSectionMeshDirty({pos.x, pos.y - 1, pos.z}, SECTIONS_PER_CHUNK - 1);
+        }
+        if (changed(BlockFace::UP)) {
+            if (section < SECTIONS_PER_CHUNK - 1)
+                chunk->markSectionMeshDirty(section + 1);
+            else
+                markSectionMeshDirty({pos.x, pos.y + 1, pos.z}, 0);
+        }
+        if (changed(BlockFace::NORTH)) markSectionMeshDirty({pos.x, pos.y, pos.z - 1}, section);
+        if (changed(BlockFace::SOUTH)) markSectionMeshDirty({pos.x, pos.y, pos.z + 1}, section);
+        if (changed(BlockFace::WEST)) markSectionMeshDirty({pos.x - 1, pos.y, pos.z}, section);
+        if (changed(BlockFace::EAST)) markSectionMeshDirty({pos.x + 1, pos.y, pos.z}, section);
     }
+}
 
-    // Ray casting for selected cube highlight
-    Ray camRay(camera.getPosition(), camera.getFrontVector());
-    std::optional<HitResult> hit = rayCast(camRay);
-    if (hit) {
-        Vec3i blockHit = hit->blockPos;
-        glm::mat4 model(1.0f);
-        model = glm::translate(model, glm::vec3(blockHit.x, blockHit.y, blockHit.z));
-        model = glm::translate(model, glm::vec3(0.5));
-        model = glm::scale(model, glm::vec3(1.01));
-        model = glm::translate(model, glm::vec3(-0.5));
-        highlightShader.use();
-        highlightShader.setMatrix4fUniform("projection", projection);
-        highlightShader.setMatrix4fUniform("view", view);
-        highlightShader.setMatrix4fUniform("model", model);
+std::vector<MeshResult> World::updateMeshes(const AtlasLayout &atlasLayout) {
+    applyLightUpdates();
 
-        glBindVertexArray(cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
+    std::vector<MeshResult> finished;
+    for (MeshResult &result : meshWorkers.collectResults()) {
+        pendingMeshJobs--;
+        // Results for unloaded chunks, or for chunks unloaded then loaded again since the job started
+        Chunk* chunk = findChunk(result.chunkCoordinate);
+        if (!chunk || !chunk->completeMeshJob(result.section, result.jobId))
+            continue;
+        finished.push_back(std::move(result));
     }
+
+    struct OutdatedSection {
+        int32_t distance;
+        Chunk* chunk;
+        Vec3i chunkCoordinate;
+        int32_t section;
+    };
+    std::vector<OutdatedSection> outdatedSections;
+    for (Chunk &chunk : chunks) {
+        const Vec3i pos = chunk.getChunkCoordinate();
+        for (int32_t section = 0; section < SECTIONS_PER_CHUNK; section++) {
+            if (chunk.needsMeshJob(section))
+                outdatedSections.push_back({ squaredDistance(pos, streamingCenter), &chunk, pos, section });
+        }
+    }
+    std::sort(outdatedSections.begin(), outdatedSections.end(), [](const OutdatedSection &a, const OutdatedSection &b) {
+        return a.distance < b.distance;
+    });
+
+    for (const auto &[distance, chunk, pos, section] : outdatedSections) {
+        // Meshing before every neighbour is loaded and lit would show faces against them, or light
+        // still spreading from them, then mesh again
+        const ChunkNeighbors &neighbors = chunk->getNeighbors();
+        const auto ready = [](const Chunk* neighbor) { return neighbor && neighbor->isLightReady(); };
+        // There are no chunks above the top of the world or below its bottom
+        const bool upReady = pos.y == WORLD_MAX_CHUNK_Y || ready(neighbors.up);
+        const bool downReady = pos.y == WORLD_MIN_CHUNK_Y || ready(neighbors.down);
+        if (!chunk->isLightReady() || !upReady || !downReady || !ready(neighbors.north) || !ready(neighbors.south)
+                || !ready(neighbors.east) || !ready(neighbors.west))
+            continue;
+
+        if (chunk->hasEmptyMesh(section, neighbors)) {
+            chunk->skipMeshJob(section);
+            finished.push_back({ pos, section, {} });
+        } else if (pendingMeshJobs < MAX_PENDING_MESH_JOBS) {
+            const uint64_t jobId = nextMeshJobId++;
+            meshWorkers.submit({
+                pos, section, jobId, meshingMode, &atlasLayout,
+                chunk->createMeshSnapshot(section, neighbors, jobId)
+            });
+            pendingMeshJobs++;
+        }
+    }
+    return finished;
 }
 
-bool World::isInWorld(Vec3i pos) const {
-    Vec2i chunkCoordinate = blockPosToChunkPos(pos);
-    return chunks.count(chunkCoordinate) == 1 && pos.y >= 0 && pos.y < CHUNK_HEIGHT;
+Chunk* World::findChunk(const Vec3i chunkCoordinate) {
+    return chunks.find(chunkCoordinate);
 }
 
-block_id World::getBlock(Vec3i pos) const {
-    if (!isInWorld(pos)) {
-        return Blocks::AIR.id;
+const Chunk* World::getChunk(const Vec3i chunkCoordinate) const {
+    return chunks.find(chunkCoordinate);
+}
+
+void World::linkNeighbors(Chunk &chunk) {
+    const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+    for (const auto &[side, opposite, dx, dy, dz] : NEIGHBOR_SIDES) {
+        Chunk* neighbor = findChunk({chunkCoordinate.x + dx, chunkCoordinate.y + dy, chunkCoordinate.z + dz});
+        chunk.setNeighbor(side, neighbor);
+        if (neighbor)
+            neighbor->setNeighbor(opposite, &chunk);
     }
+}
 
-    const Chunk &chunk = chunks.at(blockPosToChunkPos(pos));
-    pos.x %= CHUNK_SIZE;
-    if (pos.x < 0) pos.x += CHUNK_SIZE;
-    pos.z %= CHUNK_SIZE;
-    if (pos.z < 0) pos.z += CHUNK_SIZE;
+void World::unlinkNeighbors(Chunk &chunk) {
+    const Vec3i chunkCoordinate = chunk.getChunkCoordinate();
+    for (const auto &[side, opposite, dx, dy, dz] : NEIGHBOR_SIDES) {
+        if (Chunk* neighbor = findChunk({chunkCoordinate.x + dx, chunkCoordinate.y + dy, chunkCoordinate.z + dz}))
+            neighbor->setNeighbor(opposite, nullptr);
+        chunk.setNeighbor(side, nullptr);
+    }
+}
 
-    return chunk.getBlock(pos);
+void World::markSectionMeshDirty(const Vec3i chunkCoordinate, const int32_t section) {
+    if (Chunk* chunk = findChunk(chunkCoordinate))
+        chunk->markSectionMeshDirty(section);
+}
+
+void World::markBorderSectionsDirty(const Vec3i chunkCoordinate, const Vec3i min, const Vec3i max) {
+    const auto [x, y, z] = chunkCoordinate;
+    // Snapshots of the sections next to the blocks' ones hold them in their bottom or top layer
+    const int32_t sectionMin = std::max(blockYToSection(min.y - 1), 0);
+    const int32_t sectionMax = std::min(blockYToSection(max.y + 1), SECTIONS_PER_CHUNK - 1);
+    for (int32_t dx = min.x == 0 ? -1 : 0; dx <= (max.x == CHUNK_SIZE - 1 ? 1 : 0); dx++) {
+        for (int32_t dz = min.z == 0 ? -1 : 0; dz <= (max.z == CHUNK_SIZE - 1 ? 1 : 0); dz++) {
+            if (dx != 0 || dz != 0) {
+                for (int32_t section = sectionMin; section <= sectionMax; section++) {
+                    markSectionMeshDirty({x + dx, y, z + dz}, section);
+                }
+            }
+            if (min.y == 0) markSectionMeshDirty({x + dx, y - 1, z + dz}, SECTIONS_PER_CHUNK - 1);
+            if (max.y == CHUNK_HEIGHT - 1) markSectionMeshDirty({x + dx, y + 1, z + dz}, 0);
+        }
+    }
+}
+
+MeshingMode World::getMeshingMode() const {
+    return meshingMode;
+}
+
+void World::setMeshingMode(const MeshingMode mode) {
+    meshingMode = mode;
+    for (Chunk &chunk : chunks) {
+        chunk.markMeshDirty();
+    }
+}
+
+bool World::isInWorld(const Vec3i pos) const {
+    return chunks.contains(blockPosToChunkPos(pos));
+}
+
+bool World::isAreaLoaded(const Vec3i chunkCoordinate) const {
+    const int32_t minY = std::max(chunkCoordinate.y - 1, WORLD_MIN_CHUNK_Y);
+    const int32_t maxY = std::min(chunkCoordinate.y + 1, WORLD_MAX_CHUNK_Y);
+    for (int32_t x = chunkCoordinate.x - 1; x <= chunkCoordinate.x + 1; x++) {
+        for (int32_t y = minY; y <= maxY; y++) {
+            for (int32_t z = chunkCoordinate.z - 1; z <= chunkCoordinate.z + 1; z++) {
+                if (!chunks.contains({x, y, z}))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<block_id> World::getUniformSectionBlock(const Vec3i pos) const {
+    const Vec3i chunkCoordinate = blockPosToChunkPos(pos);
+    const Chunk* chunk = chunks.find(chunkCoordinate);
+    if (!chunk)
+        return Blocks::AIR.id;
+    return chunk->getUniformBlock(blockYToSection(pos.y - chunkPosToBlockPos(chunkCoordinate).y));
+}
+
+// Single reads look the chunk up directly, BlockAccessor only pays off over several nearby reads
+block_id World::getBlock(const Vec3i pos) const {
+    const Vec3i chunkCoordinate = blockPosToChunkPos(pos);
+    const Chunk* chunk = chunks.find(chunkCoordinate);
+    if (!chunk)
+        return Blocks::AIR.id;
+    const Vec3i origin = chunkPosToBlockPos(chunkCoordinate);
+    return chunk->getBlockUnchecked(pos.x - origin.x, pos.y - origin.y, pos.z - origin.z);
 }
 
 void World::setBlock(const Vec3i pos, const Block& block) {
     setBlock(pos, block.id);
 }
 
-void World::setBlock(Vec3i pos, const block_id id) {
-    if (!isInWorld(pos)) {
+void World::setBlock(const Vec3i pos, const block_id id) {
+    const Vec3i chunkCoordinate = blockPosToChunkPos(pos);
+    Chunk* chunk = findChunk(chunkCoordinate);
+    if (!chunk) {
         Logger::crash("Trying to set block outside of world");
     }
 
-    Chunk &chunk = chunks.at(blockPosToChunkPos(pos));
-    pos.x %= CHUNK_SIZE;
-    if (pos.x < 0) pos.x += CHUNK_SIZE;
-    pos.z %= CHUNK_SIZE;
-    if (pos.z < 0) pos.z += CHUNK_SIZE;
+    lightWorker.setBlocks(pos, pos, { id });
+    const Vec3i origin = chunk->getOrigin();
+    const Vec3i chunkPos(pos.x - origin.x, pos.y - origin.y, pos.z - origin.z);
+    chunk->setBlock(chunkPos, id);
+    editedChunks.insert(chunkCoordinate);
 
-    chunk.setBlock(pos, id);
+    // Blocks on the chunk border hide or reveal faces of the adjacent chunk
+    markBorderSectionsDirty(chunkCoordinate, chunkPos, chunkPos);
 }
 
 
@@ -164,24 +429,83 @@ std::optional<HitResult> World::rayCast(const Ray &ray) const {
     const char zSign = std::signbit(direction.z) ? -1 : 1;
     auto currentZ = static_cast<int32_t>(std::floor(origin.z));
 
-    for (int iteration = 0; iteration < 100; iteration++) {
-        const auto xPlane = static_cast<float>(xSign == 1 ? currentX + 1 : currentX);
-        const auto yPlane = static_cast<float>(ySign == 1 ? currentY + 1 : currentY);
-        const auto zPlane = static_cast<float>(zSign == 1 ? currentZ + 1 : currentZ);
+    // Number of blocks stepped through, skipped sections included
+    int32_t steps = 0;
+    BlockAccessor blocks(*this);
+    while (steps < RAYCAST_MAX_STEPS) {
+        // The ray leaves the current block, or the whole section when it is uniform air
+        Vec3i boxMin(currentX, currentY, currentZ);
+        Vec3i boxMax(currentX + 1, currentY + 1, currentZ + 1);
+        const std::optional<block_id> uniform = blocks.getUniformSectionBlock(boxMin);
+        if (uniform && Blocks::isAir(*uniform)) {
+            const Vec3i chunkOrigin = chunkPosToBlockPos(blockPosToChunkPos(boxMin));
+            const int32_t section = blockYToSection(currentY);
+            boxMin = { chunkOrigin.x, section * SECTION_HEIGHT, chunkOrigin.z };
+            boxMax = { boxMin.x + CHUNK_SIZE, boxMin.y + SECTION_HEIGHT, boxMin.z + CHUNK_SIZE };
+        }
+
+        const auto xPlane = static_cast<float>(xSign == 1 ? boxMax.x : boxMin.x);
+        const auto yPlane = static_cast<float>(ySign == 1 ? boxMax.y : boxMin.y);
+        const auto zPlane = static_cast<float>(zSign == 1 ? boxMax.z : boxMin.z);
 
         const float tx = (xPlane - origin.x) / direction.x;
         const float ty = (yPlane - origin.y) / direction.y;
         const float tz = (zPlane - origin.z) / direction.z;
 
-        if (tx < ty && tx < tz) currentX += xSign;
-        else if (ty < tz) currentY += ySign;
-        else currentZ += zSign;
+        // Block where the ray exits the box, clamped against floating point errors
+        const auto blockAt = [&](const float t, const int axis, const int32_t min, const int32_t max) {
+            const auto coordinate = static_cast<int32_t>(std::floor(origin[axis] + direction[axis] * t));
+            return std::clamp(coordinate, min, max - 1);
+        };
+
+        const Vec3i previous(currentX, currentY, currentZ);
+        if (tx < ty && tx < tz) {
+            currentX = xSign == 1 ? boxMax.x : boxMin.x - 1;
+            currentY = blockAt(tx, 1, boxMin.y, boxMax.y);
+            currentZ = blockAt(tx, 2, boxMin.z, boxMax.z);
+        } else if (ty < tz) {
+            currentX = blockAt(ty, 0, boxMin.x, boxMax.x);
+            currentY = ySign == 1 ? boxMax.y : boxMin.y - 1;
+            currentZ = blockAt(ty, 2, boxMin.z, boxMax.z);
+        } else {
+            currentX = blockAt(tz, 0, boxMin.x, boxMax.x);
+            currentY = blockAt(tz, 1, boxMin.y, boxMax.y);
+            currentZ = zSign == 1 ? boxMax.z : boxMin.z - 1;
+        }
+        steps += std::abs(currentX - previous.x) + std::abs(currentY - previous.y) + std::abs(currentZ - previous.z);
+        if (steps > RAYCAST_MAX_STEPS)
+            break;
 
         Vec3i blockPos(currentX, currentY, currentZ);
-        if (getBlock(blockPos) != Blocks::AIR) {
+        if (!Blocks::isAir(blocks.getBlock(blockPos))) {
             return rayCubeIntersection(ray, blockPos);
         }
     }
 
     return std::nullopt;
 }
+
+vector<AABB> World::getCollisionBoxes(const Vec3i min, const Vec3i max) const {
+    vector<AABB> collisionBoxes;
+    BlockAccessor blocks(*this);
+    for (auto x = min.x; x <= max.x; x++) {
+        for (auto z = min.z; z <= max.z; z++) {
+            for (auto y = min.y; y <= max.y;) {
+                // Blocks of uniform sections are known without looking them up one by one
+                if (const std::optional<block_id> uniform = blocks.getUniformSectionBlock({x, y, z})) {
+                    const int32_t sectionEnd = std::min((blockYToSection(y) + 1) * SECTION_HEIGHT, max.y + 1);
+                    for (; y < sectionEnd; y++) {
+                        if (Blocks::isSolid(*uniform))
+                            collisionBoxes.push_back(AABB::ofBlock({x, y, z}));
+                    }
+                    continue;
+                }
+
+                if (Blocks::isSolid(blocks.getBlock({x, y, z})))
+                    collisionBoxes.push_back(AABB::ofBlock({x, y, z}));
+                y++;
+            }
+        }
+    }
+    return collisionBoxes;
+}
@@ -1,38 +1,112 @@
 #ifndef WORLD_HPP
 #define WORLD_HPP
 
-#include <unordered_map>
+#include <memory>
+#include <unordered_set>
+#include <vector>
 
 #include "world/chunk.hpp"
+#include "world/chunkMap.hpp"
+#include "world/chunkMesher.hpp"
+#include "world/editWorkerPool.hpp"
+#include "world/meshWorkerPool.hpp"
+#include "texturemanip/atlasLayout.hpp"
 #include "math/vectors.hpp"
 #include "math/raycast.hpp"
+#include "math/aabb.hpp"
 #include "world/blocks.hpp"
-#include "camera.hpp"
+#include "world/chunkSaveWorker.hpp"
+#include "world/generationPipeline.hpp"
+#include "world/lightWorker.hpp"
+#include "world/regionStorage.hpp"
+#include "world/terrainGenerator.hpp"
+
+// Radius in chunks of the area loaded around the player
+#define DEFAULT_RENDER_DISTANCE 8
+// Chunks loaded above and below the player's chunk, the world being much wider than the terrain is deep
+#define VERTICAL_RENDER_DISTANCE 2
 
 class World {
-    unordered_map<Vec2i, Chunk> chunks;
-    Shader chunkShader {
-        "assets/shaders/chunk.vert",
-        "assets/shaders/chunk.frag"
-    };
-    Shader highlightShader {
-        "assets/shaders/highlight.vert",
-        "assets/shaders/highlight.frag"
-    };
-    GLuint cubeVAO = 0;
+    // Bulk edits write into chunks directly and mark them edited and dirty once committed
+    friend class WorldEdit;
+
+    ChunkMap chunks;
+    std::unique_ptr<TerrainGenerator> generator;
+    GenerationPipeline generation;
+    std::unique_ptr<ChunkSaveWorker> saveWorker; // nullptr when chunks are not saved
+    // Loaded chunks edited since the last autosave
+    unordered_set<Vec3i> editedChunks;
+    LightWorker lightWorker;
+    EditWorkerPool editWorkers; // Idle between the edits of WorldEdit
+    // Destroyed first, its workers being joined before anything they may read goes away
+    MeshWorkerPool meshWorkers;
+    MeshingMode meshingMode = MeshingMode::GREEDY;
+    uint32_t pendingMeshJobs = 0;
+    uint64_t nextMeshJobId = 1;
+    uint64_t nextLightLoadId = 1;
+
+    int32_t renderDistance = 0;
+    // Offsets from the player's chunk of the chunks within the render distance, nearest first
+    std::vector<Vec3i> loadOrder;
+    Vec3i streamingCenter {0, 0, 0};
+    std::vector<Vec3i> unloadedChunks;
+
+    [[nodiscard]] Chunk* findChunk(Vec3i chunkCoordinate);
+    // Links the chunk and its loaded neighbours to each other, or unlinks them before it unloads
+    void linkNeighbors(Chunk &chunk);
+    void unlinkNeighbors(Chunk &chunk);
+    void markSectionMeshDirty(Vec3i chunkCoordinate, int32_t section);
+    // Marks the sections of adjacent chunks, diagonal ones included, whose meshes show the blocks between min and
+    // max, both inclusive and relative to the chunk, by culling or occluding their faces
+    void markBorderSectionsDirty(Vec3i chunkCoordinate, Vec3i min, Vec3i max);
+    // Copies the light computed in the background into the chunks, marking the meshes showing it dirty
+    void applyLightUpdates();
 
 public:
-    World();
+    // Chunks are loaded from storage when they were saved, and generated otherwise.
+    explicit World(std::unique_ptr<TerrainGenerator> generator, std::unique_ptr<RegionStorage> storage = nullptr,
+        int32_t renderDistance = DEFAULT_RENDER_DISTANCE);
+
+    [[nodiscard]] int32_t getRenderDistance() const;
+    void setRenderDistance(int32_t distance);
+    // Unloads chunks out of the render distance around center, horizontally and VERTICAL_RENDER_DISTANCE
+    // vertically, queuing the changed ones for saving, and loads missing ones, nearest first. Loads are
+    // spread over several calls, returns whether every chunk in range is loaded.
+    bool updateLoadedChunks(Vec3i center);
+    // Queues the chunks edited since the last autosave for saving in the background, returns their number.
+    // Generated chunks are only saved once unloaded or by saveChunks.
+    int32_t autosave();
+    // Queues every loaded chunk with unsaved changes for saving, returns their number. Queued chunks are
+    // written before the world is destroyed.
+    int32_t saveChunks();
+    // Returns the chunks unloaded since the last call, so their meshes can be released.
+    [[nodiscard]] std::vector<Vec3i> collectUnloadedChunks();
+
+    // Submits mesh jobs for outdated sections, nearest to the player first, and returns the meshes finished
+    // since the last call. Chunks are meshed once they and their six neighbours are loaded and lit. Sections
+    // known to have no visible faces get an empty mesh without a job.
+    [[nodiscard]] std::vector<MeshResult> updateMeshes(const AtlasLayout &atlasLayout);
 
-    void draw(const Camera &camera, const Atlas &atlas);
+    [[nodiscard]] MeshingMode getMeshingMode() const;
+    void setMeshingMode(MeshingMode mode);
 
+    // Whether the block is in a loaded chunk.
     [[nodiscard]] bool isInWorld(Vec3i pos) const;
+    // Whether the chunk and every chunk around it, diagonal ones included, are loaded. There are no chunks to
+    // load above the top of the world or below its bottom.
+    [[nodiscard]] bool isAreaLoaded(Vec3i chunkCoordinate) const;
+    // nullptr when the chunk is not loaded.
+    [[nodiscard]] const Chunk* getChunk(Vec3i chunkCoordinate) const;
 
     [[nodiscard]] block_id getBlock(Vec3i pos) const;
+    // The block filling the whole chunk section containing pos, if the section is uniform.
+    [[nodiscard]] std::optional<block_id> getUniformSectionBlock(Vec3i pos) const;
     void setBlock(Vec3i pos, block_id id);
     void setBlock(Vec3i pos, const Block& block);
 
     [[nodiscard]] std::optional<HitResult> rayCast(const Ray &ray) const;
+    // Boxes of the solid blocks between min and max, both inclusive.
+    [[nodiscard]] vector<AABB> getCollisionBoxes(Vec3i min, Vec3i max) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "world/worldEdit.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "world/blocks.hpp"
+#include "world/chunk.hpp"
+#include "world/world.hpp"
+
+// Chunks an edit must overlap to be spread over threads, smaller ones are not worth waking the workers
+#define PARALLEL_EDIT_MIN_CHUNKS 4
+
+BlockBuffer::BlockBuffer(const Vec3i size):
+    size(size), blocks(static_cast<size_t>(size.x) * size.y * size.z, Blocks::AIR.id) {}
+
+Vec3i BlockBuffer::getSize() const {
+    return size;
+}
+
+block_id BlockBuffer::get(const Vec3i pos) const {
+    return column(pos.x, pos.z)[pos.y];
+}
+
+void BlockBuffer::set(const Vec3i pos, const block_id id) {
+    column(pos.x, pos.z)[pos.y] = id;
+}
+
+const block_id* BlockBuffer::column(const int32_t x, const int32_t z) const {
+    return blocks.data() + (static_cast<size_t>(x) * size.z + z) * size.y;
+}
+
+block_id* BlockBuffer::column(const int32_t x, const int32_t z) {
+    return blocks.data() + (static_cast<size_t>(x) * size.z + z) * size.y;
+}
+
+WorldEdit::WorldEdit(World &world, const bool parallel): world(world), parallel(parallel) {}
+
+WorldEdit::~WorldEdit() {
+    commit();
+}
+
+int64_t WorldEdit::editChunks(Vec3i min, Vec3i max, const std::function<int32_t(Chunk&, Vec3i, Vec3i)> &edit) {
+    min.y = std::max(min.y, WORLD_MIN_Y);
+    max.y = std::min(max.y, WORLD_MAX_Y);
+    if (min.x > max.x || min.y > max.y || min.z > max.z)
+        return 0;
+
+    struct ChunkTask {
+        Chunk* chunk;
+        Vec3i min;
+        Vec3i max;
+        int32_t changed;
+    };
+    std::vector<ChunkTask> tasks;
+    const Vec3i minChunk = blockPosToChunkPos(min);
+    const Vec3i maxChunk = blockPosToChunkPos(max);
+    for (int32_t chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++) {
+        for (int32_t chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++) {
+            for (int32_t chunkZ = minChunk.z; chunkZ <= maxChunk.z; chunkZ++) {
+                Chunk* chunk = world.findChunk({chunkX, chunkY, chunkZ});
+                if (!chunk)
+                    continue;
+
+                const Vec3i origin = chunk->getOrigin();
+                tasks.push_back({
+                    chunk,
+                    { std::max(min.x - origin.x, 0), std::max(min.y - origin.y, 0), std::max(min.z - origin.z, 0) },
+                    {
+                        std::min(max.x - origin.x, CHUNK_SIZE - 1),
+                        std::min(max.y - origin.y, CHUNK_HEIGHT - 1),
+                        std::min(max.z - origin.z, CHUNK_SIZE - 1)
+                    },
+                    0
+                });
+            }
+        }
+    }
+
+    // Chunks only write their own storage, so each can be edited on its own thread
+    if (parallel && tasks.size() >= PARALLEL_EDIT_MIN_CHUNKS) {
+        world.editWorkers.runTasks(tasks.size(), [&tasks, &edit](const size_t i) {
+            tasks[i].changed = edit(*tasks[i].chunk, tasks[i].min, tasks[i].max);
+        });
+    } else {
+        for (ChunkTask &task : tasks) {
+            task.changed = edit(*task.chunk, task.min, task.max);
+        }
+    }
+
+    int64_t changed = 0;
+    for (const ChunkTask &task : tasks) {
+        if (task.changed == 0)
+            continue;
+        changed += task.changed;
+
+        const auto [it, inserted] = editedBoxes.try_emplace(task.chunk->getChunkCoordinate(), task.min, task.max);
+        if (!inserted) {
+            EditedBox &box = it->second;
+            box.min = { std::min(box.min.x, task.min.x), std::min(box.min.y, task.min.y), std::min(box.min.z, task.min.z) };
+            box.max = { std::max(box.max.x, task.max.x), std::max(box.max.y, task.max.y), std::max(box.max.z, task.max.z) };
+        }
+    }
+    return changed;
+}
+
+int64_t WorldEdit::fillBox(const Vec3i min, const Vec3i max, const block_id id) {
+    return editChunks(min, max, [id](Chunk &chunk, const Vec3i chunkMin, const Vec3i chunkMax) {
+        return chunk.fillBox(chunkMin, chunkMax, id);
+    });
+}
+
+int64_t WorldEdit::fillSphere(const Vec3i center, const int32_t radius, const block_id id) {
+    const Vec3i min(center.x - radius, center.y - radius, center.z - radius);
+    const Vec3i max(center.x + radius, center.y + radius, center.z + radius);
+    // Same rounding as the render distance: squared distances up to radius * (radius + 1)
+    const int32_t limit = radius * radius + radius;
+    return editChunks(min, max, [&](Chunk &chunk, const Vec3i chunkMin, const Vec3i chunkMax) {
+        const Vec3i chunkOrigin = chunk.getOrigin();
+        const int32_t chunkCenterY = center.y - chunkOrigin.y;
+        int32_t changed = 0;
+        for (int32_t x = chunkMin.x; x <= chunkMax.x; x++) {
+            for (int32_t z = chunkMin.z; z <= chunkMax.z; z++) {
+                const int32_t dx = chunkOrigin.x + x - center.x;
+                const int32_t dz = chunkOrigin.z + z - center.z;
+                const int32_t remaining = limit - dx * dx - dz * dz;
+                if (remaining < 0)
+                    continue;
+
+                // Every block of the column within the sphere in one box
+                const auto halfHeight = static_cast<int32_t>(std::sqrt(static_cast<double>(remaining)));
+                const int32_t yMin = std::max(chunkCenterY - halfHeight, chunkMin.y);
+                const int32_t yMax = std::min(chunkCenterY + halfHeight, chunkMax.y);
+                if (yMin <= yMax)
+                    changed += chunk.fillBox({x, yMin, z}, {x, yMax, z}, id);
+            }
+        }
+        return changed;
+    });
+}
+
+int64_t WorldEdit::replace(const Vec3i min, const Vec3i max, const block_id from, const block_id to) {
+    return editChunks(min, max, [from, to](Chunk &chunk, const Vec3i chunkMin, const Vec3i chunkMax) {
+        return chunk.replace(chunkMin, chunkMax, from, to);
+    });
+}
+
+int64_t WorldEdit::paste(const Vec3i origin, const BlockBuffer &buffer, const bool skipAir) {
+    const Vec3i size = buffer.getSize();
+    const Vec3i max(origin.x + size.x - 1, origin.y + size.y - 1, origin.z + size.z - 1);
+    return editChunks(origin, max, [&](Chunk &chunk, const Vec3i chunkMin, const Vec3i chunkMax) {
+        const Vec3i chunkOrigin = chunk.getOrigin();
+        int32_t changed = 0;
+        for (int32_t x = chunkMin.x; x <= chunkMax.x; x++) {
+            for (int32_t z = chunkMin.z; z <= chunkMax.z; z++) {
+                const block_id* column = buffer.column(chunkOrigin.x + x - origin.x, chunkOrigin.z + z - origin.z);
+                changed += chunk.pasteColumn(x, z, chunkMin.y, chunkMax.y + 1,
+                    column + (chunkOrigin.y + chunkMin.y - origin.y), skipAir);
+            }
+        }
+        return changed;
+    });
+}
+
+BlockBuffer WorldEdit::copy(const Vec3i min, const Vec3i max) const {
+    BlockBuffer buffer({ max.x - min.x + 1, max.y - min.y + 1, max.z - min.z + 1 });
+    const int32_t minChunkY = blockPosToChunkPos(min).y;
+    const int32_t maxChunkY = blockPosToChunkPos(max).y;
+    for (int32_t x = min.x; x <= max.x; x++) {
+        for (int32_t z = min.z; z <= max.z; z++) {
+            for (int32_t chunkY = minChunkY; chunkY <= maxChunkY; chunkY++) {
+                const Vec3i chunkCoordinate = blockPosToChunkPos({x, chunkY * CHUNK_HEIGHT, z});
+                if (const Chunk* chunk = world.getChunk(chunkCoordinate)) {
+                    const Vec3i origin = chunk->getOrigin();
+                    chunk->copyColumn(x - origin.x, z - origin.z, min.y - origin.y, max.y + 1 - origin.y,
+                        buffer.column(x - min.x, z - min.z));
+                }
+            }
+        }
+    }
+    return buffer;
+}
+
+void WorldEdit::commit() {
+    for (const auto &[chunkCoordinate, box] : editedBoxes) {
+        Chunk* chunk = world.findChunk(chunkCoordinate);
+        if (!chunk)
+            continue;
+        world.editedChunks.insert(chunkCoordinate);
+
+        const Vec3i origin = chunk->getOrigin();
+        world.lightWorker.setBlocks(
+            { origin.x + box.min.x, origin.y + box.min.y, origin.z + box.min.z },
+            { origin.x + box.max.x, origin.y + box.max.y, origin.z + box.max.z },
+            chunk->copyBox(box.min, box.max)
+        );
+
+        // Blocks on section and chunk borders hide or reveal faces of the adjacent sections, like setBlock
+        const int32_t firstSection = blockYToSection(box.min.y);
+        const int32_t lastSection = blockYToSection(box.max.y);
+        const int32_t belowSection = box.min.y % SECTION_HEIGHT == 0 ? std::max(firstSection - 1, 0) : firstSection;
+        const int32_t aboveSection = box.max.y % SECTION_HEIGHT == SECTION_HEIGHT - 1
+            ? std::min(lastSection + 1, SECTIONS_PER_CHUNK - 1) : lastSection;
+        for (int32_t section = belowSection; section <= aboveSection; section++) {
+            chunk->markSectionMeshDirty(section);
+        }
+        world.markBorderSectionsDirty(chunkCoordinate, box.min, box.max);
+    }
+    editedBoxes.clear();
+}
@@ -0,0 +1,79 @@
+#ifndef VOXELS_WORLDEDIT_HPP
+#define VOXELS_WORLDEDIT_HPP
+
+#include <functional>
+#include <vector>
+
+#include "math/vectors.hpp"
+#include "world/block.hpp"
+
+class Chunk;
+class World;
+
+// Blocks of a box, copied from a world or filled by hand, to paste into a world.
+class BlockBuffer {
+    Vec3i size;
+    std::vector<block_id> blocks; // Columns from bottom to top, indexed by x then z
+
+public:
+    // Starts filled with air.
+    explicit BlockBuffer(Vec3i size);
+
+    [[nodiscard]] Vec3i getSize() const;
+    // Buffer-relative position, with no bounds checks.
+    [[nodiscard]] block_id get(Vec3i pos) const;
+    void set(Vec3i pos, block_id id);
+    // The blocks of the column at x, z, from bottom to top.
+    [[nodiscard]] const block_id* column(int32_t x, int32_t z) const;
+    [[nodiscard]] block_id* column(int32_t x, int32_t z);
+};
+
+/**
+ * Batch of bulk edits to the loaded chunks of a world. Edits write straight into the storage of the chunks
+ * they overlap, one chunk per task, spread over the world's edit workers when they cover many chunks.
+ * Committing marks the edited sections, and the adjacent ones their faces depend on, for remeshing once, the
+ * edited chunks for the next autosave, and queues the edited blocks for relighting. Blocks outside the loaded
+ * chunks are left out.
+ *
+ * Chunks must not be loaded or unloaded before the batch is committed, which the destructor does.
+ */
+class WorldEdit {
+    // Chunk-relative box holding the blocks changed in a chunk, both bounds inclusive
+    struct EditedBox {
+        Vec3i min;
+        Vec3i max;
+    };
+
+    World &world;
+    bool parallel;
+    unordered_map<Vec3i, EditedBox> editedBoxes;
+
+    // Runs edit on every loaded chunk overlapping the box between min and max, both inclusive, with the box
+    // clipped to the chunk in chunk-relative coordinates. Records the boxes where edit changed blocks and
+    // returns the number of blocks changed.
+    int64_t editChunks(Vec3i min, Vec3i max, const std::function<int32_t(Chunk&, Vec3i, Vec3i)> &edit);
+
+public:
+    // Edits of a single chunk always run on the calling thread, parallel allows larger ones to use more.
+    explicit WorldEdit(World &world, bool parallel = true);
+    ~WorldEdit();
+
+    WorldEdit(const WorldEdit&) = delete;
+    WorldEdit& operator=(const WorldEdit&) = delete;
+
+    // Each edit returns the number of blocks it changed. Bounds are inclusive.
+    int64_t fillBox(Vec3i min, Vec3i max, block_id id);
+    // Fills the blocks whose centre is within radius + 0.5 blocks of the centre of the block at center.
+    int64_t fillSphere(Vec3i center, int32_t radius, block_id id);
+    int64_t replace(Vec3i min, Vec3i max, block_id from, block_id to);
+    // Writes the buffer with its first block at origin, leaving the world's blocks where the buffer has air
+    // when skipAir is set.
+    int64_t paste(Vec3i origin, const BlockBuffer &buffer, bool skipAir = false);
+    // The blocks between min and max, edits of this batch included. Blocks outside the loaded chunks are air.
+    [[nodiscard]] BlockBuffer copy(Vec3i min, Vec3i max) const;
+
+    // Schedules the meshes of the sections edited since the last commit for rebuilding.
+    void commit();
+};
+
+#endif //VOXELS_WORLDEDIT_HPP